@@ -0,0 +1,399 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_bench.cc
+//---------------------------------------------------------------------------//
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <G4Box.hh>
+#include <G4LogicalVolume.hh>
+#include <G4LogicalVolumeStore.hh>
+#include <G4Material.hh>
+#include <G4NistManager.hh>
+#include <G4PVPlacement.hh>
+#include <G4PVReplica.hh>
+#include <G4PhysicalConstants.hh>
+#include <G4PhysicalVolumeStore.hh>
+#include <G4ReflectionFactory.hh>
+#include <G4SolidStore.hh>
+#include <G4TessellatedSolid.hh>
+#include <G4ThreeVector.hh>
+#include <G4Transform3D.hh>
+#include <G4TriangularFacet.hh>
+#include <G4UnionSolid.hh>
+#include <VecGeom/management/GeoManager.h>
+#include <sys/resource.h>
+
+#include "G4VG.hh"
+
+namespace g4vg
+{
+namespace bench
+{
+namespace
+{
+//---------------------------------------------------------------------------//
+// HELPER FUNCTIONS
+//---------------------------------------------------------------------------//
+//! Get the default material
+G4Material* get_material()
+{
+    return G4NistManager::Instance()->FindOrBuildMaterial("G4_AIR");
+}
+
+//---------------------------------------------------------------------------//
+//! Create a box logical volume
+G4LogicalVolume*
+make_box_lv(std::string const& name, double hx, double hy, double hz)
+{
+    return new G4LogicalVolume(
+        new G4Box(name, hx, hy, hz), get_material(), name);
+}
+
+//---------------------------------------------------------------------------//
+//! Place the world volume
+G4VPhysicalVolume* place_world(G4LogicalVolume* world_lv)
+{
+    return new G4PVPlacement(G4Transform3D{},
+                             world_lv,
+                             "world_pv",
+                             /* parent = */ nullptr,
+                             /* many = */ false,
+                             /* copy_no = */ 0);
+}
+
+//---------------------------------------------------------------------------//
+//! Place a daughter without rotation
+void place(G4LogicalVolume* lv,
+           G4ThreeVector const& pos,
+           G4LogicalVolume* mother,
+           int copy_no = 0)
+{
+    new G4PVPlacement(nullptr,
+                      pos,
+                      lv,
+                      lv->GetName() + "_pv",
+                      mother,
+                      /* many = */ false,
+                      copy_no);
+}
+
+//---------------------------------------------------------------------------//
+//! Delete all Geant4 and VecGeom geometry
+void clear_geometry()
+{
+    vecgeom::GeoManager::Instance().Clear();
+    G4ReflectionFactory::Instance()->Clean();
+    G4PhysicalVolumeStore::Clean();
+    G4LogicalVolumeStore::Clean();
+    G4SolidStore::Clean();
+}
+
+//---------------------------------------------------------------------------//
+//! Get the peak resident set size of this process in MiB
+double get_peak_rss_mib()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    // Reported in bytes
+    return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+    // Reported in KiB
+    return usage.ru_maxrss / 1024.0;
+#endif
+}
+
+//---------------------------------------------------------------------------//
+// GEOMETRY BUILDERS
+//---------------------------------------------------------------------------//
+/*!
+ * World with N box daughters on a cubic grid.
+ */
+G4VPhysicalVolume* build_flat(int n)
+{
+    int const side = static_cast<int>(std::ceil(std::cbrt(n)));
+    double const half = side + 1.0;
+    auto* world_lv = make_box_lv("world", half, half, half);
+    auto* box_lv = make_box_lv("box", 0.4, 0.4, 0.4);
+    for (int i = 0; i < n; ++i)
+    {
+        G4ThreeVector pos(i % side, (i / side) % side, i / (side * side));
+        place(box_lv, 2 * pos - G4ThreeVector(side, side, side), world_lv, i);
+    }
+    return place_world(world_lv);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * World with N box daughters on a cubic grid, each with its own solid and LV.
+ *
+ * This exercises the solid and logical volume caches, which have one entry
+ * per distinct Geant4 object.
+ */
+G4VPhysicalVolume* build_distinct(int n)
+{
+    int const side = static_cast<int>(std::ceil(std::cbrt(n)));
+    double const half = side + 1.0;
+    auto* world_lv = make_box_lv("world", half, half, half);
+    for (int i = 0; i < n; ++i)
+    {
+        double const size = 0.2 + 0.2 * (i % 2);
+        auto* box_lv
+            = make_box_lv("box" + std::to_string(i), size, size, size);
+        G4ThreeVector pos(i % side, (i / side) % side, i / (side * side));
+        place(box_lv, 2 * pos - G4ThreeVector(side, side, side), world_lv);
+    }
+    return place_world(world_lv);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Chain of N boxes, each with a distinct LV, nested inside each other.
+ */
+G4VPhysicalVolume* build_nested(int n)
+{
+    double half = 2.0 * (n + 1);
+    auto* world_lv = make_box_lv("world", half, half, half);
+    auto* mother = world_lv;
+    for (int i = 0; i < n; ++i)
+    {
+        half -= 1.0;
+        auto* lv = make_box_lv("level" + std::to_string(i), half, half, half);
+        place(lv, {}, mother);
+        mother = lv;
+    }
+    return place_world(world_lv);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Box divided by an N-way replica along x.
+ */
+G4VPhysicalVolume* build_replica(int n)
+{
+    auto* world_lv = make_box_lv("world", n + 1.0, 2, 2);
+    auto* container_lv = make_box_lv("container", n, 1, 1);
+    place(container_lv, {}, world_lv);
+    auto* cell_lv = make_box_lv("cell", 1, 1, 1);
+    new G4PVReplica("cell_pv", cell_lv, container_lv, kXAxis, n, 2.0);
+    return place_world(world_lv);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Tessellated sphere with about N triangular facets.
+ */
+G4VPhysicalVolume* build_tessellated(int n)
+{
+    int const num_seg = std::max(3, static_cast<int>(std::sqrt(n / 2.0)));
+    double const radius = 10;
+    auto vertex = [&](int i, int j) {
+        double const theta = CLHEP::pi * i / num_seg;
+        double const phi = 2 * CLHEP::pi * j / num_seg;
+        return radius
+               * G4ThreeVector(std::sin(theta) * std::cos(phi),
+                               std::sin(theta) * std::sin(phi),
+                               std::cos(theta));
+    };
+    auto* solid = new G4TessellatedSolid("sphere");
+    auto add_facet = [solid](G4ThreeVector const& a,
+                             G4ThreeVector const& b,
+                             G4ThreeVector const& c) {
+        solid->AddFacet(new G4TriangularFacet(a, b, c, ABSOLUTE));
+    };
+    for (int j = 0; j < num_seg; ++j)
+    {
+        // Top and bottom caps
+        add_facet(vertex(0, j), vertex(1, j), vertex(1, j + 1));
+        add_facet(vertex(num_seg - 1, j),
+                  vertex(num_seg, j),
+                  vertex(num_seg - 1, j + 1));
+        for (int i = 1; i < num_seg - 1; ++i)
+        {
+            add_facet(vertex(i, j), vertex(i + 1, j), vertex(i + 1, j + 1));
+            add_facet(vertex(i, j), vertex(i + 1, j + 1), vertex(i, j + 1));
+        }
+    }
+    solid->SetSolidClosed(true);
+
+    auto* world_lv = make_box_lv("world", 2 * radius, 2 * radius, 2 * radius);
+    auto* lv = new G4LogicalVolume(solid, get_material(), "sphere");
+    place(lv, {}, world_lv);
+    return place_world(world_lv);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Left-deep tree of N unions of displaced boxes.
+ */
+G4VPhysicalVolume* build_boolean(int n)
+{
+    G4VSolid* solid = new G4Box("b0", 1, 1, 1);
+    for (int i = 1; i < n; ++i)
+    {
+        auto* box = new G4Box("b" + std::to_string(i), 1, 1, 1);
+        solid = new G4UnionSolid("u" + std::to_string(i),
+                                 solid,
+                                 box,
+                                 nullptr,
+                                 G4ThreeVector(1.5 * i, 0, 0));
+    }
+    double const half = 1.5 * n + 1;
+    auto* world_lv = make_box_lv("world", half, half, half);
+    auto* lv = new G4LogicalVolume(solid, get_material(), "union");
+    place(lv, {}, world_lv);
+    return place_world(world_lv);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * N modules, every other one reflected through the reflection factory.
+ */
+G4VPhysicalVolume* build_reflected(int n)
+{
+    auto* world_lv = make_box_lv("world", 2.0 * n + 2, 4, 4);
+    auto* module_lv = make_box_lv("module", 1, 2, 2);
+    auto* inner_lv = make_box_lv("inner", 0.5, 0.5, 0.5);
+    place(inner_lv, {0, 0.5, 1}, module_lv);
+
+    for (int i = 0; i < n; ++i)
+    {
+        G4Translate3D const pos(4.0 * i - 2.0 * n, 0, 0);
+        G4Transform3D const trans = (i % 2 == 0)
+                                        ? G4Transform3D(pos)
+                                        : G4Transform3D(pos * G4ReflectZ3D());
+        G4ReflectionFactory::Instance()->Place(
+            trans, "module_pv", module_lv, world_lv, false, i);
+    }
+    return place_world(world_lv);
+}
+
+//---------------------------------------------------------------------------//
+// BENCHMARK DRIVER
+//---------------------------------------------------------------------------//
+using BuildFunc = G4VPhysicalVolume* (*)(int);
+
+struct Case
+{
+    BuildFunc build;
+    std::vector<int> sizes;
+};
+
+//! Synthetic geometries and default problem sizes
+std::map<std::string, Case> const& get_cases()
+{
+    static std::map<std::string, Case> const cases = {
+        {"flat", {build_flat, {1000, 10000, 100000}}},
+        {"distinct", {build_distinct, {1000, 10000, 100000}}},
+        {"nested", {build_nested, {10, 100, 1000}}},
+        {"replica", {build_replica, {100, 1000, 10000}}},
+        {"tessellated", {build_tessellated, {1000, 10000, 100000}}},
+        {"boolean", {build_boolean, {10, 100, 1000}}},
+        {"reflected", {build_reflected, {10, 100, 1000}}},
+    };
+    return cases;
+}
+
+//---------------------------------------------------------------------------//
+//! Build, convert, and report one geometry
+void run(std::string const& name,
+         BuildFunc build,
+         int size,
+         Options const& options)
+{
+    G4VPhysicalVolume* world = build(size);
+
+    auto start = std::chrono::steady_clock::now();
+    Converted converted = g4vg::convert(world, options);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now()
+                                            - start;
+
+    auto& geo = vecgeom::GeoManager::Instance();
+    std::cout << name << ',' << size << ',' << elapsed.count() << ','
+              << get_peak_rss_mib() << ',' << geo.GetRegisteredVolumesCount()
+              << ',' << geo.GetPlacedVolumesCount() << ','
+              << converted.logical_volumes.size() << ','
+              << converted.physical_volumes.size() << std::endl;
+
+    clear_geometry();
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace
+}  // namespace bench
+}  // namespace g4vg
+
+//---------------------------------------------------------------------------//
+/*!
+ * Run the conversion benchmarks.
+ *
+ * Usage: g4vg_bench [-j THREADS] [CASE [SIZE ...]]
+ *
+ * Without arguments, all cases are run at their default sizes. The output is
+ * CSV with the conversion wall time, the peak resident set size of the
+ * process (which never decreases, so run a single case and size per process
+ * to measure its memory), and the number of VecGeom logical and placed
+ * volumes.
+ */
+int main(int argc, char* argv[])
+{
+    using namespace g4vg::bench;
+
+    g4vg::Options options;
+    std::vector<std::string> args(argv + 1, argv + argc);
+    if (args.size() >= 2 && args[0] == "-j")
+    {
+        options.num_threads = std::stoi(args[1]);
+        args.erase(args.begin(), args.begin() + 2);
+    }
+
+    auto const& cases = get_cases();
+    std::vector<std::pair<std::string, std::vector<int>>> todo;
+    if (args.empty())
+    {
+        for (auto const& [name, c] : cases)
+        {
+            todo.push_back({name, c.sizes});
+        }
+    }
+    else
+    {
+        if (!cases.count(args[0]))
+        {
+            std::cerr << "Unknown case '" << args[0] << "': expected one of";
+            for (auto const& kv : cases)
+            {
+                std::cerr << ' ' << kv.first;
+            }
+            std::cerr << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::vector<int> sizes;
+        for (auto iter = args.begin() + 1; iter != args.end(); ++iter)
+        {
+            sizes.push_back(std::stoi(*iter));
+        }
+        todo.push_back(
+            {args[0], sizes.empty() ? cases.at(args[0]).sizes : sizes});
+    }
+
+    std::cout << "case,size,seconds,peak_rss_mib,vg_logical,vg_placed,"
+                 "g4vg_logical,g4vg_placed"
+              << std::endl;
+    for (auto const& [name, sizes] : todo)
+    {
+        for (int size : sizes)
+        {
+            run(name, cases.at(name).build, size, options);
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -6,7 +6,13 @@
 //---------------------------------------------------------------------------//
 #include "G4VG.hh"
 
+#include <algorithm>
+
+#include "g4vg_impl/Assert.hh"
 #include "g4vg_impl/Converter.hh"
+#include "g4vg_impl/NavigationValidator.hh"
+#include "g4vg_impl/PlacementUpdater.hh"
+#include "g4vg_impl/VolumeIndex.hh"
 
 namespace g4vg
 {
@@ -37,5 +43,90 @@ Converted convert(G4VPhysicalVolume const* world, Options const& options)
     return convert(world);
 }
 
+//---------------------------------------------------------------------------//
+/*!
+ * Find the VecGeom ID of a Geant4 logical volume.
+ *
+ * The result is null if the volume was not converted.
+ */
+Converted::LvIndexEntry const*
+find_lv(Converted const& converted, G4LogicalVolume const* lv)
+{
+    auto const& index = converted.lv_index;
+    Converted::LvIndexEntry const key{lv, 0};
+    auto iter
+        = std::lower_bound(index.begin(), index.end(), key, LvIndexLess{});
+    if (iter == index.end() || iter->lv != lv)
+    {
+        return nullptr;
+    }
+    return &(*iter);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Find the lowest VecGeom ID of a copy of a Geant4 physical volume.
+ *
+ * The copy number is that of the replica or parameterisation instance, or of
+ * the volume itself if it's a normal placement. A physical volume can be
+ * placed more than once if the VecGeom reflection factory duplicates its
+ * mother, so the first match is returned. The result is null if the copy was
+ * not placed.
+ */
+Converted::PvIndexEntry const*
+find_pv(Converted const& converted, G4VPhysicalVolume const* pv, int copy_no)
+{
+    auto const& index = converted.pv_index;
+    Converted::PvIndexEntry const key{pv, copy_no, 0};
+    auto iter
+        = std::lower_bound(index.begin(), index.end(), key, PvIndexLess{});
+    if (iter == index.end() || iter->pv != pv || iter->copy_no != copy_no)
+    {
+        return nullptr;
+    }
+    return &(*iter);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Move converted placements to match their modified Geant4 volumes.
+ *
+ * The options must be the ones used for conversion. The VecGeom IDs of all
+ * volumes are unchanged. Only the transforms of existing placements are
+ * updated: changes to solids, materials, or logical volumes are not detected
+ * or reconverted, since VecGeom placed volumes are specialized on their
+ * unplaced solids, and such changes require a new conversion. If any volume
+ * can't be updated, an exception is thrown before any placement is moved.
+ */
+void update_placements(Converted const& converted,
+                       Converted::VecPv const& changed,
+                       Options const& options)
+{
+    PlacementUpdater update{converted, options};
+    update(changed);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Compare navigation through Geant4 and the converted geometry.
+ *
+ * Random rays are traced through the Geant4 world with \c G4Navigator and
+ * through the converted VecGeom world, and the sequences of volumes and step
+ * lengths are compared. The VecGeom world must already be closed with
+ * \c GeoManager::SetWorldAndClose , and each step uses the navigator set up
+ * for the current volume, so the navigator and acceleration structures used
+ * by the application are the ones checked. The options must be the ones used
+ * for conversion, and the conversion must include the whole geometry:
+ * volumes omitted by compact replicas, compact voxels, or pruning will show
+ * up as mismatches.
+ */
+Validation validate_navigation(Converted const& converted,
+                               Options const& options,
+                               ValidateOptions const& validate_options)
+{
+    NavigationValidator validate{converted, options, validate_options};
+    return validate();
+}
+
 //---------------------------------------------------------------------------//
 }  // namespace g4vg
@@ -6,6 +6,12 @@
 //---------------------------------------------------------------------------//
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
 #include <vector>
 
 //---------------------------------------------------------------------------//
@@ -13,6 +19,7 @@
 //---------------------------------------------------------------------------//
 
 class G4LogicalVolume;
+class G4Material;
 class G4VPhysicalVolume;
 
 namespace vecgeom
@@ -37,6 +44,9 @@ namespace g4vg
  */
 struct Options
 {
+    //! Predicate for selecting logical volumes
+    using PruneDaughters = std::function<bool(G4LogicalVolume const&)>;
+
     //! Print extra messages for debugging
     bool verbose{false};
 
@@ -51,6 +61,164 @@ struct Options
 
     //! Value of 1mm in native unit system (0.1 for cm)
     double scale = 1;
+
+    //! Threads used to convert solids (1 for serial, 0 for one per core)
+    unsigned int num_threads{1};
+
+    //! Share one VecGeom solid among structurally identical Geant4 solids
+    bool deduplicate_solids{false};
+
+    //! Record conversion timing and counters in \c Converted::stats
+    bool statistics{false};
+
+    //! Place one copy of each replica and describe the rest in \c replicas
+    bool compact_replicas{false};
+
+    //! Describe regular box voxel phantoms in \c voxel_grids
+    bool compact_voxels{false};
+
+    //! Flatten union trees with at least this many components (0 to disable)
+    unsigned int multiunion_threshold{0};
+
+    //! Share temporary placements of the same solid with the same transform
+    bool pool_temp_volumes{false};
+
+    //! Random points per solid to compare with Geant4 (0 to disable)
+    //! (per-type results are always returned in \c Converted::stats )
+    unsigned int verify_samples{0};
+
+    //! Tolerance for making nearly equal placement transforms identical
+    //! (0 merges only exact copies; this doesn't share transform memory)
+    double transform_tolerance{0};
+
+    //! Move displacements of leaf volume solids into their placements
+    bool absorb_displaced{false};
+
+    //! Build mirror images of reflected primitives instead of scaled shapes
+    bool fold_reflections{false};
+
+    //! Remove no-op boolean operations and rebalance deep union trees
+    bool simplify_booleans{false};
+
+    //! Write a Chrome trace of the conversion to this file (empty to disable)
+    std::string trace_file{};
+
+    //! Convert but don't place the daughters of LVs for which this is true
+    PruneDaughters prune_daughters{};
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Timing and counters collected during conversion.
+ *
+ * Times are wall-clock seconds. The per-type solid times are inclusive: a
+ * boolean solid's time includes the time to convert its constituents. When
+ * solids are converted in parallel, the per-type times are summed over all
+ * threads and may exceed the wall time of the solid phase.
+ */
+struct Statistics
+{
+    //! Number of solids of a single type and the time to convert them
+    struct SolidType
+    {
+        std::size_t count{0};
+        double time{0};
+        //! Points compared with Geant4 (see \c Options::verify_samples )
+        std::size_t samples{0};
+        //! Compared points where Geant4 and VecGeom disagree
+        std::size_t mismatches{0};
+    };
+
+    using MapSolidType = std::map<std::string, SolidType>;
+
+    //! Number and approximate heap size of objects of one kind
+    struct MemoryUsage
+    {
+        std::size_t count{0};
+        std::size_t bytes{0};
+    };
+
+    using MapMemoryUsage = std::map<std::string, MemoryUsage>;
+
+    /*!
+     * Approximate memory used by the converted geometry and the converter.
+     *
+     * Sizes are estimated from the object sizes reported by VecGeom and the
+     * capacities of the containers, not measured from the allocator.
+     */
+    struct Memory
+    {
+        //! VecGeom unplaced volumes keyed by demangled type
+        MapMemoryUsage unplaced;
+        //! Logical volumes converted from Geant4
+        MemoryUsage logical_volumes;
+        //! Temporary "[TEMP]" logical volumes for composite solids
+        MemoryUsage temp_logical_volumes;
+        //! Placements of Geant4 volumes, including stamped copies
+        MemoryUsage placed_volumes;
+        //! Temporary placements of composite solid constituents
+        MemoryUsage temp_placed_volumes;
+        //! Distinct placement transforms
+        MemoryUsage transforms;
+        //! Triangles of tessellated solids (bytes of vertex storage)
+        MemoryUsage tessellated_facets;
+        //! Converter cache of Geant4 to VecGeom solids
+        MemoryUsage solid_cache;
+        //! Converter cache of Geant4 to VecGeom logical volumes
+        MemoryUsage lv_cache;
+        //! Converter set of volumes whose daughters were placed
+        MemoryUsage built_daughters;
+        //! Volume maps and indexes in \c Converted
+        MemoryUsage volume_maps;
+        //! Increase of the process's peak resident set size during conversion
+        std::size_t peak_rss_delta{0};
+    };
+
+    //! Time to find the logical volumes used by the world
+    double discovery_time{0};
+    //! Time to convert solids and logical volumes
+    double solid_time{0};
+    //! Time to place daughter volumes
+    double placement_time{0};
+    //! Time to build the output volume maps
+    double volume_map_time{0};
+    //! Time to verify converted solids against Geant4
+    double verify_time{0};
+
+    //! Solid conversions keyed by Geant4 entity type
+    MapSolidType solid_types;
+
+    //! Temporary "[TEMP]" logical volumes created for composite solids
+    std::size_t temp_lvs{0};
+    //! Temporary placements shared instead of created (see \c Options )
+    std::size_t pooled_temp_volumes{0};
+    //! Boolean operations removed because they don't change the result
+    std::size_t pruned_booleans{0};
+    //! Deep union trees rebuilt as balanced trees
+    std::size_t rebalanced_unions{0};
+    //! Placed volumes stamped from Geant4 replicas
+    std::size_t replica_copies{0};
+    //! Placed volumes stamped from Geant4 parameterisations
+    std::size_t param_copies{0};
+    //! Solids that reused a structurally identical VecGeom solid
+    std::size_t deduplicated_solids{0};
+    //! Duplicate tessellated solid vertices merged into a shared vertex
+    std::size_t welded_vertices{0};
+    //! Tessellated facets thinner than the surface tolerance that were removed
+    std::size_t degenerate_facets{0};
+    //! Distinct placement transforms after sharing nearly identical ones
+    std::size_t distinct_transforms{0};
+    //! Distinct transforms without translation or rotation
+    std::size_t identity_transforms{0};
+    //! Distinct transforms with only a translation
+    std::size_t translation_transforms{0};
+    //! Distinct transforms with only a rotation
+    std::size_t rotation_transforms{0};
+    //! Distinct transforms whose rotation only permutes and flips axes
+    std::size_t permutation_transforms{0};
+
+    //! Approximate memory usage
+    Memory memory;
 };
 
 //---------------------------------------------------------------------------//
@@ -87,14 +255,105 @@ struct Options
  creates a single
  * volume placement in this case, but it returns a reference to the placed
  volume and the associated parameterisation.
+ *
+ * With \c Options::compact_replicas , each Geant4 replica is placed only once
+ * (as copy zero) and its replication data is saved in \c replicas . The other
+ * copies are \em not part of the VecGeom geometry, so the application must
+ * locate them itself using the replication axis, width, and offset as in
+ * \c G4ReplicaNavigation .
+ *
+ * With \c Options::compact_voxels , a box that is completely filled by a
+ * regular grid of voxels (a \c G4PhantomParameterisation or a parameterisation
+ * nested inside two replicas) is converted without daughters. Its voxel
+ * dimensions and the material of each voxel are saved in \c voxel_grids .
+ *
+ * Boolean, reflected, and some other composite solids are built from
+ * temporary "[TEMP]" logical and placed volumes. VecGeom registers them with
+ * its geometry manager, so they take IDs in between those of the converted
+ * volumes, and their entries in \c logical_volumes and \c physical_volumes
+ * are null. Their IDs are listed in \c temp_lv_ids and \c temp_pv_ids so that
+ * they can be told apart from IDs of volumes that weren't converted.
+ *
+ * The converted "world" can be any physical volume: its subtree is converted
+ * and it is placed at the origin regardless of its position in its mother.
+ * A volume can be looked up by name with \c G4PhysicalVolumeStore::GetVolume.
+ * Logical volumes selected by \c Options::prune_daughters are converted as
+ * solid envelopes of their own material, and nothing below them is visited.
+ *
+ * The \c lv_index and \c pv_index members map Geant4 volumes back to VecGeom
+ * IDs. They're sorted for binary search by \c find_lv and \c find_pv . A
+ * reflected Geant4 LV is converted as its unreflected constituent and is not
+ * in the index. Replica copies that aren't placed (see above) are also
+ * missing.
+ *
+ * After the translation or rotation of a normal Geant4 placement is changed
+ * (e.g. for alignment), \c update_placements can move the corresponding
+ * VecGeom placed volumes without converting again. Any navigation
+ * acceleration structures (such as the VecGeom BVH) must then be rebuilt.
+ * Modified solids and logical volumes are not reconverted by this update and
+ * require a new conversion.
  */
 struct Converted
 {
     using VGPlacedVolume = vecgeom::VPlacedVolume;
     using VecLv = std::vector<G4LogicalVolume const*>;
     using VecPv = std::vector<G4VPhysicalVolume const*>;
+    using LogicalVolumeId = unsigned int;
     using PlacedVolumeId = unsigned int;
 
+    //! VecGeom ID of a converted Geant4 logical volume
+    struct LvIndexEntry
+    {
+        G4LogicalVolume const* lv{nullptr};
+        LogicalVolumeId id{0};
+    };
+    using VecLvIndex = std::vector<LvIndexEntry>;
+
+    //! VecGeom ID of a placed copy of a Geant4 physical volume
+    struct PvIndexEntry
+    {
+        G4VPhysicalVolume const* pv{nullptr};
+        int copy_no{0};
+        PlacedVolumeId id{0};
+    };
+    using VecPvIndex = std::vector<PvIndexEntry>;
+
+    //! Replicated volume whose copies share a single placement
+    struct Replica
+    {
+        //! VecGeom ID of the placed first copy
+        PlacedVolumeId id{0};
+        //! Replication axis (Geant4 \c EAxis value)
+        int axis{0};
+        //! Number of copies
+        int count{0};
+        //! Width of each copy (native length, or radians for phi)
+        double width{0};
+        //! Offset of the first copy (native length, or radians for phi)
+        double offset{0};
+    };
+    using VecReplica = std::vector<Replica>;
+
+    //! Regular grid of box voxels that fill a logical volume
+    struct VoxelGrid
+    {
+        //! VecGeom ID of the logical volume filled by the grid
+        unsigned int lv_id{0};
+        //! Geant4 parameterised volume of a single voxel
+        G4VPhysicalVolume const* pv{nullptr};
+        //! Number of voxels along x, y, and z
+        std::array<int, 3> dims{{0, 0, 0}};
+        //! Half-width of a voxel along x, y, and z (native length)
+        std::array<double, 3> half_width{{0, 0, 0}};
+        //! Materials used by the voxels
+        std::vector<G4Material const*> materials;
+        //! Index into \c materials for each voxel, with x varying fastest
+        std::vector<std::uint32_t> material_ids;
+    };
+    using VecVoxelGrid = std::vector<VoxelGrid>;
+    using VecLvId = std::vector<LogicalVolumeId>;
+    using VecPvId = std::vector<PlacedVolumeId>;
+
     //! World pointer (host) corresponding to input Geant4 world
     VGPlacedVolume* world{nullptr};
 
@@ -102,16 +361,121 @@ struct Converted
     VecLv logical_volumes;
     //! Geant4 PVs indexed by VecGeom PlacedVolume ID
     VecPv physical_volumes;
+    //! Logical volume IDs sorted by Geant4 pointer (see \c find_lv )
+    VecLvIndex lv_index;
+    //! Placed volume IDs sorted by Geant4 pointer and copy (see \c find_pv )
+    VecPvIndex pv_index;
     //! Encountered volumes that have unsupported nested parameterisations
     VecPv nested_pv;
+    //! Replicas placed only once (see \c Options::compact_replicas)
+    VecReplica replicas;
+    //! Voxel grids that are not placed (see \c Options::compact_voxels)
+    VecVoxelGrid voxel_grids;
+    //! Sorted IDs of temporary logical volumes for composite solids
+    VecLvId temp_lv_ids;
+    //! Sorted IDs of temporary placed volumes for composite solids
+    VecPvId temp_pv_ids;
+    //! Conversion statistics, if requested in the options (solid
+    //! verification results and time are filled in whenever it's enabled)
+    Statistics stats;
 };
 
 //---------------------------------------------------------------------------//
-// Convert a Geant4 geometry to a VecGeom geometry.
+/*!
+ * Options for comparing navigation in Geant4 and converted VecGeom geometry.
+ */
+struct ValidateOptions
+{
+    //! Number of random rays to trace
+    std::size_t num_rays{1000};
+
+    //! Threads used to trace rays (1 for serial, 0 for one per core)
+    unsigned int num_threads{1};
+
+    //! Seed for the ray origins and directions
+    std::uint64_t seed{0};
+
+    //! Maximum number of steps along a single ray
+    int max_steps{10000};
+
+    //! Absolute (or relative, for long steps) step length tolerance [mm]
+    double tolerance{1e-6};
+
+    //! Maximum number of mismatches to describe in detail
+    std::size_t max_mismatches{10};
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Result of comparing navigation in Geant4 and converted VecGeom geometry.
+ *
+ * Each ray is traced until it leaves the world or the two navigators
+ * disagree on the next volume or the length of a step. Only the first
+ * mismatch along each ray is counted.
+ */
+struct Validation
+{
+    //! First disagreement along a ray
+    struct Mismatch
+    {
+        //! Index of the ray
+        std::size_t ray{0};
+        //! Step along the ray, starting with zero for the initial location
+        int step{0};
+        //! Start of the step in the Geant4 world [mm]
+        std::array<double, 3> pos{{0, 0, 0}};
+        //! Direction of the ray
+        std::array<double, 3> dir{{0, 0, 0}};
+        //! Volume and copy number located by Geant4 after the step
+        G4VPhysicalVolume const* g4_pv{nullptr};
+        int g4_copy_no{-1};
+        //! Volume (from \c Converted::physical_volumes ) located by VecGeom
+        G4VPhysicalVolume const* vg_pv{nullptr};
+        int vg_copy_no{-1};
+        //! Length of the step [mm]
+        double g4_step{0};
+        double vg_step{0};
+    };
+    using VecMismatch = std::vector<Mismatch>;
+
+    //! Number of rays that started inside the world
+    std::size_t num_rays{0};
+    //! Number of steps that agreed
+    std::size_t num_steps{0};
+    //! Rays where the located volumes differ
+    std::size_t volume_mismatches{0};
+    //! Rays where the step lengths differ
+    std::size_t step_mismatches{0};
+    //! Rays that reached the step limit
+    std::size_t truncated{0};
+    //! Details of the first few mismatches (ordered by ray)
+    VecMismatch mismatches;
+};
+
+//---------------------------------------------------------------------------//
+// Convert a Geant4 geometry (or subtree) to a VecGeom geometry.
 Converted convert(G4VPhysicalVolume const* world);
 
 // Convert with custom options
 Converted convert(G4VPhysicalVolume const* world, Options const& options);
 
+// Find the VecGeom ID of a Geant4 logical volume
+Converted::LvIndexEntry const*
+find_lv(Converted const& converted, G4LogicalVolume const* lv);
+
+// Find the lowest VecGeom ID of a copy of a Geant4 physical volume
+Converted::PvIndexEntry const*
+find_pv(Converted const& converted, G4VPhysicalVolume const* pv, int copy_no);
+
+// Move converted placements to match their modified Geant4 volumes
+void update_placements(Converted const& converted,
+                       Converted::VecPv const& changed,
+                       Options const& options);
+
+// Compare navigation through Geant4 and the converted geometry
+Validation validate_navigation(Converted const& converted,
+                               Options const& options,
+                               ValidateOptions const& validate_options);
+
 //---------------------------------------------------------------------------//
 }  // namespace g4vg
@@ -0,0 +1,65 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/AbsorbedDisplacement.cc
+//---------------------------------------------------------------------------//
+#include "AbsorbedDisplacement.hh"
+
+#include <G4DisplacedSolid.hh>
+#include <G4LogicalVolume.hh>
+#include <G4ReflectionFactory.hh>
+
+#include "Assert.hh"
+
+namespace g4vg
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Find the displacement to absorb into the placements of a logical volume.
+ *
+ * A displacement can only be absorbed if the volume's top-level solid is
+ * displaced and the volume has no daughters (whose placements are relative to
+ * the displaced frame). With the reflection factory, constituents of
+ * reflected volumes are excluded because their reflected placements would
+ * need the displacement to be reflected as well. Nested displacements are
+ * combined.
+ *
+ * The result is empty if the displacement can't be absorbed.
+ */
+AbsorbedDisplacement
+find_absorbed_displacement(G4LogicalVolume const& lv, bool reflection_factory)
+{
+    AbsorbedDisplacement result;
+
+    auto const* displaced
+        = dynamic_cast<G4DisplacedSolid const*>(lv.GetSolid());
+    if (!displaced || lv.GetNoDaughters() > 0)
+    {
+        return result;
+    }
+    if (reflection_factory
+        && G4ReflectionFactory::Instance()->IsConstituent(
+            const_cast<G4LogicalVolume*>(&lv)))
+    {
+        return result;
+    }
+
+    // Combine from the outermost displacement inward
+    G4AffineTransform transform;
+    G4VSolid const* solid = displaced;
+    while (displaced)
+    {
+        transform = displaced->GetTransform().Invert() * transform;
+        solid = displaced->GetConstituentMovedSolid();
+        G4VG_ASSERT(solid);
+        displaced = dynamic_cast<G4DisplacedSolid const*>(solid);
+    }
+
+    result.solid = solid;
+    result.transform = transform;
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
@@ -0,0 +1,39 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/AbsorbedDisplacement.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <G4AffineTransform.hh>
+
+class G4LogicalVolume;
+class G4VSolid;
+
+namespace g4vg
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Displacement of a logical volume's solid that's moved into its placements.
+ *
+ * The transform maps the underlying solid's frame into the logical volume's
+ * frame, so the placement of the underlying solid in a mother is
+ * <code>transform * placement</code>.
+ */
+struct AbsorbedDisplacement
+{
+    G4VSolid const* solid{nullptr};
+    G4AffineTransform transform;
+
+    //! Whether the displacement is absorbed
+    explicit operator bool() const { return solid != nullptr; }
+};
+
+//---------------------------------------------------------------------------//
+// Find the displacement to absorb into the placements of a logical volume
+AbsorbedDisplacement
+find_absorbed_displacement(G4LogicalVolume const& lv, bool reflection_factory);
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
@@ -6,8 +6,10 @@
 //---------------------------------------------------------------------------//
 #include "Converter.hh"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
+#include <string>
 #include <unordered_set>
 #include <utility>
 #include <G4LogicalVolumeStore.hh>
@@ -16,17 +18,27 @@
 #include <G4VNestedParameterisation.hh>
 #include <G4VPVParameterisation.hh>
 #include <G4VPhysicalVolume.hh>
+#include <VecGeom/base/Vector3D.h>
+#include <VecGeom/management/GeoManager.h>
 #include <VecGeom/management/ReflFactory.h>
 #include <VecGeom/volumes/LogicalVolume.h>
 #include <VecGeom/volumes/PlacedVolume.h>
+#include <VecGeom/volumes/UnplacedVolume.h>
 
+#include "AbsorbedDisplacement.hh"
 #include "Logger.hh"
 #include "LogicalVolumeConverter.hh"
+#include "MemoryUsage.hh"
 #include "PrintableLV.hh"
 #include "Scaler.hh"
 #include "SolidConverter.hh"
+#include "SolidVerifier.hh"
+#include "Stopwatch.hh"
+#include "TraceWriter.hh"
 #include "Transformer.hh"
 #include "TypeDemangler.hh"
+#include "VolumeIndex.hh"
+#include "VoxelGridConverter.hh"
 
 namespace g4vg
 {
@@ -43,42 +55,84 @@ G4LogicalVolume const* get_constituent_lv(G4LogicalVolume const& lv)
 //---------------------------------------------------------------------------//
 /*!
  * Build a VecGeom transform from a Geant4 physical volume.
+ *
+ * An absorbed displacement of the daughter's solid is applied before the
+ * placement.
  */
 vecgeom::Transformation3D
-build_transform(Transformer const& convert, G4VPhysicalVolume const& g4pv)
+build_transform(Transformer const& convert,
+                G4VPhysicalVolume const& g4pv,
+                AbsorbedDisplacement const& absorbed)
 {
+    if (absorbed)
+    {
+        return convert(absorbed.transform
+                       * G4AffineTransform(g4pv.GetRotation(),
+                                           g4pv.GetTranslation()));
+    }
     return convert(g4pv.GetTranslation(), g4pv.GetRotation());
 }
 
 //---------------------------------------------------------------------------//
-//! Add all visited logical volumes to a set.
+/*!
+ * Add all visited logical volumes to a set.
+ *
+ * The hierarchy is traversed with an explicit stack, and the daughters of a
+ * volume are only visited the first time the volume is encountered, so the
+ * cost is linear in the number of distinct volumes.
+ */
 struct LVMapVisitor
 {
     bool reflection_factory{true};
-    std::unordered_set<G4LogicalVolume const*>* all_lv;
+    VoxelGridConverter const* convert_voxels{nullptr};
+    Options::PruneDaughters const* prune{nullptr};
+    InstanceSet<G4LogicalVolume const*>* all_lv;
 
-    void operator()(G4LogicalVolume const* lv)
+    void operator()(G4LogicalVolume const* world_lv)
     {
-        G4VG_EXPECT(lv);
-        if (reflection_factory)
+        G4VG_EXPECT(world_lv);
+        std::vector<G4LogicalVolume const*> stack{world_lv};
+        while (!stack.empty())
         {
-            if (auto const* unrefl_lv = get_constituent_lv(*lv))
+            G4LogicalVolume const* lv = stack.back();
+            stack.pop_back();
+            G4VG_ASSERT(lv);
+            if (reflection_factory)
             {
-                // Visit underlying instead of reflected
-                return (*this)(unrefl_lv);
+                if (auto const* unrefl_lv = get_constituent_lv(*lv))
+                {
+                    // Visit underlying instead of reflected
+                    lv = unrefl_lv;
+                }
             }
-        }
 
-        // Add this LV
-        all_lv->insert(lv);
+            if (!all_lv->insert(lv))
+            {
+                // Daughters have already been visited
+                continue;
+            }
 
-        // Visit daughters
-        using size_type = decltype(lv->GetNoDaughters());
-        for (size_type i = 0, imax = lv->GetNoDaughters(); i != imax; ++i)
-        {
-            G4VPhysicalVolume const* daughter{lv->GetDaughter(i)};
-            G4VG_ASSERT(daughter);
-            (*this)(daughter->GetLogicalVolume());
+            if (convert_voxels && convert_voxels->is_grid(*lv))
+            {
+                // Voxels won't be placed
+                continue;
+            }
+
+            if (prune && *prune && (*prune)(*lv))
+            {
+                // Daughters won't be placed
+                continue;
+            }
+
+            // Visit daughters
+            using size_type = decltype(lv->GetNoDaughters());
+            for (size_type i = 0, imax = lv->GetNoDaughters(); i != imax;
+                 ++i)
+            {
+                G4VPhysicalVolume const* daughter{lv->GetDaughter(i)};
+                G4VG_ASSERT(daughter);
+                stack.push_back(daughter->GetLogicalVolume());
+            }
         }
     }
 };
@@ -86,6 +140,9 @@ struct LVMapVisitor
 //---------------------------------------------------------------------------//
 /*!
  * Place a daughter in a mother, accounting for reflection.
+ *
+ * The VecGeom daughter volume, whose own daughters must already be placed,
+ * corresponds to the unreflected Geant4 volume.
  */
 class DaughterPlacer
 {
@@ -93,21 +150,28 @@ class DaughterPlacer
     using VGLogicalVolume = vecgeom::LogicalVolume;
     using VGPlacedVolume = vecgeom::VPlacedVolume;
     using VecPv = std::vector<G4VPhysicalVolume const*>;
+    using VecPvIndex = Converted::VecPvIndex;
 
-    template<class F>
-    DaughterPlacer(F&& build_vgdaughter,
-                   bool reflection_factory,
-                   Transformer const& trans,
+    DaughterPlacer(Options const& options,
+                   TraceWriter* trace,
+                   Transformer& trans,
                    VecPv* placed_volumes,
+                   VecPvIndex* pv_index,
                    G4LogicalVolume const* daughter_g4lv,
+                   VGLogicalVolume* daughter_lv,
                    VGLogicalVolume* mother_lv)
-        : reflection_factory_{reflection_factory}
+        : reflection_factory_{options.reflection_factory}
+        , trace_{trace}
         , convert_transform_{trans}
         , placed_pv_{placed_volumes}
+        , pv_index_{pv_index}
         , mother_lv_{mother_lv}
+        , daughter_lv_{daughter_lv}
     {
         G4VG_EXPECT(placed_pv_);
+        G4VG_EXPECT(pv_index_);
         G4VG_EXPECT(daughter_g4lv);
+        G4VG_EXPECT(daughter_lv_);
         G4VG_EXPECT(mother_lv_);
 
         // Test for reflection
@@ -124,12 +188,16 @@ class DaughterPlacer
             }
         }
 
-        daughter_lv_ = build_vgdaughter(daughter_g4lv);
-        G4VG_ENSURE(daughter_lv_);
+        if (options.absorb_displaced)
+        {
+            // Move the solid's displacement into the placement
+            absorbed_ = find_absorbed_displacement(*daughter_g4lv,
+                                                   reflection_factory_);
+        }
     }
 
     //! Using Geant4 daughter physical volume, place the VecGeom daughter
-    void operator()(G4VPhysicalVolume const* g4pv) const
+    VGPlacedVolume const* operator()(G4VPhysicalVolume const* g4pv) const
     {
         G4VG_EXPECT(g4pv);
 
@@ -142,7 +210,8 @@ class DaughterPlacer
             // Use the VGDML reflection factory to place the daughter in the
             // mother (it must *always* be used, in case parent is reflected)
             vecgeom::ReflFactory::Instance().Place(
-                build_transform(convert_transform_, *g4pv),
+                convert_transform_.intern(
+                    build_transform(convert_transform_, *g4pv, absorbed_)),
                 reflvec,
                 g4pv->GetName(),
                 daughter_lv_,
@@ -155,7 +224,8 @@ class DaughterPlacer
         }
         else
         {
-            auto transform = build_transform(convert_transform_, *g4pv);
+            auto const& transform = convert_transform_.intern(
+                build_transform(convert_transform_, *g4pv, absorbed_));
             auto* placed
                 = daughter_lv_->Place(g4pv->GetName().c_str(), &transform);
             G4VG_ASSERT(placed);
@@ -170,12 +240,19 @@ class DaughterPlacer
         placed_pv_->resize(std::max<std::size_t>(placed_pv_->size(), id + 1),
                            nullptr);
         (*placed_pv_)[id] = g4pv;
+        pv_index_->push_back({g4pv, vgpv->GetCopyNo(), id});
+        return vgpv;
     }
 
     //! Place replica daughters: see ReplicaUpdater, ParamUpdater
     template<class F>
     void operator()(G4VPhysicalVolume* g4pv, F&& update_pv) const
     {
+        TraceSpan span(trace_, g4pv->GetName(), "replica");
+        if (span)
+        {
+            span.arg("copies", std::to_string(g4pv->GetMultiplicity()));
+        }
         for (int j = 0, jmax = g4pv->GetMultiplicity(); j < jmax; ++j)
         {
             // Modify the volume's position and place the copy
@@ -187,13 +264,47 @@ class DaughterPlacer
 
   private:
     bool reflection_factory_;
-    Transformer const& convert_transform_;
+    TraceWriter* trace_{nullptr};
+    Transformer& convert_transform_;
     VecPv* placed_pv_{nullptr};
+    VecPvIndex* pv_index_{nullptr};
     VGLogicalVolume* mother_lv_{nullptr};
     VGLogicalVolume* daughter_lv_{nullptr};
     bool flip_z_{false};
+    AbsorbedDisplacement absorbed_;
 };
 
+//---------------------------------------------------------------------------//
+/*!
+ * Describe all copies of a replica whose first copy has been placed.
+ */
+Converted::Replica make_replica(Scaler const& convert_scale,
+                                G4VPhysicalVolume const& g4pv,
+                                unsigned int id)
+{
+    EAxis axis;
+    G4int num_replicas;
+    G4double width;
+    G4double offset;
+    G4bool consuming;
+    g4pv.GetReplicationData(axis, num_replicas, width, offset, consuming);
+
+    Converted::Replica result;
+    result.id = id;
+    result.axis = static_cast<int>(axis);
+    result.count = num_replicas;
+    result.width = width;
+    result.offset = offset;
+    if (axis != EAxis::kPhi)
+    {
+        // Phi replicas are replicated by angle rather than length
+        result.width = convert_scale(width);
+        result.offset = convert_scale(offset);
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
 struct ReplicaUpdater
 {
     void operator()(int copy_no, G4VPhysicalVolume* g4pv)
@@ -221,12 +332,21 @@ struct ParamUpdater
 Converter::Converter(Options const& options)
     : options_{options}
     , convert_scale_{std::make_unique<Scaler>(options.scale)}
-    , convert_transform_{std::make_unique<Transformer>(*convert_scale_)}
+    , convert_transform_{std::make_unique<Transformer>(
+          *convert_scale_, options.transform_tolerance)}
+    , trace_{options.trace_file.empty()
+                 ? nullptr
+                 : std::make_unique<TraceWriter>(options.trace_file)}
     , convert_solid_{std::make_unique<SolidConverter>(
-          *convert_scale_, *convert_transform_, options.compare_volumes)}
-    , convert_lv_{std::make_unique<LogicalVolumeConverter>(
-          *convert_solid_, options_.append_pointers)}
+          *convert_scale_, *convert_transform_, options, trace_.get())}
+    , convert_lv_{std::make_unique<LogicalVolumeConverter>(*convert_solid_,
+                                                           options_)}
 {
+    if (options_.compact_voxels)
+    {
+        convert_voxels_
+            = std::make_unique<VoxelGridConverter>(*convert_scale_);
+    }
 }
 
 //---------------------------------------------------------------------------//
@@ -237,41 +357,174 @@ Converter::~Converter() = default;
 auto Converter::operator()(arg_type g4world) -> result_type
 {
     G4VG_EXPECT(g4world);
-    G4VG_EXPECT(!g4world->GetRotation());
-    G4VG_EXPECT(g4world->GetTranslation() == G4ThreeVector(0, 0, 0));
 
     G4VG_LOG(status) << "Converting Geant4 geometry";
+    std::size_t const start_rss = options_.statistics ? peak_rss() : 0;
 
     // Recurse through physical volumes once to build underlying LV
-    std::unordered_set<G4LogicalVolume const*> all_g4lv;
-    all_g4lv.reserve(G4LogicalVolumeStore::GetInstance()->size());
-    LVMapVisitor{options_.reflection_factory,
-                 &all_g4lv}(g4world->GetLogicalVolume());
+    Stopwatch get_time;
+    auto const& lv_store = *G4LogicalVolumeStore::GetInstance();
+    InstanceSet<G4LogicalVolume const*> all_g4lv;
+    if (!lv_store.empty())
+    {
+        // Volumes are stored in construction order, so the last has the
+        // largest instance ID
+        all_g4lv.reserve(instance_id(*lv_store.back()) + 1);
+    }
+    {
+        TraceSpan span(trace_.get(), "discovery", "phase");
+        LVMapVisitor{options_.reflection_factory,
+                     convert_voxels_.get(),
+                     &options_.prune_daughters,
+                     &all_g4lv}(g4world->GetLogicalVolume());
+    }
+    stats_.discovery_time = get_time();
+
+    get_time = Stopwatch{};
+    if (options_.num_threads != 1)
+    {
+        TraceSpan span(trace_.get(), "preconvert", "phase");
+        // Convert the underlying solids in parallel: the serial pass below
+        // will then only create the VecGeom volumes, keeping IDs identical
+        std::vector<G4VSolid const*> solids;
+        solids.reserve(all_g4lv.size());
+        for (auto* lv : lv_store)
+        {
+            if (all_g4lv.count(lv))
+            {
+                solids.push_back(lv->GetSolid());
+            }
+        }
+        convert_solid_->preconvert(solids, options_.num_threads);
+    }
 
     // Convert visited volumes in instance order to try to approximate layout
     // of Geant4
-    for (auto* lv : *G4LogicalVolumeStore::GetInstance())
+    for (auto* lv : lv_store)
     {
         if (all_g4lv.count(lv))
         {
+            TraceSpan span(trace_.get(), lv->GetName(), "logical volume");
             (*convert_lv_)(*lv);
         }
     }
+    stats_.solid_time = get_time();
 
-    // Place world volume
+    // Place world volume (or subtree root) at the origin
+    get_time = Stopwatch{};
     VGLogicalVolume* world_lv
         = this->build_with_daughters(g4world->GetLogicalVolume());
-    auto trans = build_transform(*convert_transform_, *g4world);
+    vecgeom::Transformation3D trans;
+    if (options_.absorb_displaced)
+    {
+        if (auto absorbed = find_absorbed_displacement(
+                *g4world->GetLogicalVolume(), options_.reflection_factory))
+        {
+            // Leaf root volume with a displaced solid
+            trans = (*convert_transform_)(absorbed.transform);
+        }
+    }
     auto* world_pv = world_lv->Place(g4world->GetName().c_str(), &trans);
     G4VG_ASSERT(world_pv);
     G4VG_ASSERT(world_pv->id() == placed_volumes_.size());
     placed_volumes_.push_back(g4world);
+    pv_index_.push_back({g4world, world_pv->GetCopyNo(), world_pv->id()});
+    stats_.placement_time = get_time();
+
+    if (options_.deduplicate_solids)
+    {
+        auto num_solids = convert_solid_->num_solids();
+        auto num_dedup = convert_solid_->num_deduplicated();
+        G4VG_LOG(info) << "Deduplicated " << num_dedup << " of "
+                       << num_solids << " solids ("
+                       << (num_solids ? 100.0 * num_dedup / num_solids : 0.0)
+                       << "% shared)";
+    }
 
     result_type result;
     result.world = world_pv;
+    get_time = Stopwatch{};
     result.logical_volumes = convert_lv_->make_volume_map();
+    for (std::size_t i = 0; i != result.logical_volumes.size(); ++i)
+    {
+        if (auto const* g4lv = result.logical_volumes[i])
+        {
+            result.lv_index.push_back(
+                {g4lv, static_cast<Converted::LogicalVolumeId>(i)});
+        }
+    }
+    std::sort(result.lv_index.begin(), result.lv_index.end(), LvIndexLess{});
+    std::sort(pv_index_.begin(), pv_index_.end(), PvIndexLess{});
+    stats_.volume_map_time = get_time();
     result.physical_volumes = std::move(placed_volumes_);
+    result.pv_index = std::move(pv_index_);
     result.nested_pv = std::move(nested_);
+    result.replicas = std::move(replicas_);
+    result.voxel_grids = std::move(voxel_grids_);
+    for (auto const* pv : convert_solid_->temp_placed())
+    {
+        result.temp_lv_ids.push_back(pv->GetLogicalVolume()->id());
+        result.temp_pv_ids.push_back(pv->id());
+    }
+    std::sort(result.temp_lv_ids.begin(), result.temp_lv_ids.end());
+    std::sort(result.temp_pv_ids.begin(), result.temp_pv_ids.end());
+
+    if (options_.statistics)
+    {
+        stats_.solid_types = convert_solid_->type_stats();
+        stats_.temp_lvs = convert_solid_->num_temp_lvs();
+        stats_.pooled_temp_volumes = convert_solid_->num_pooled();
+        stats_.pruned_booleans = convert_solid_->num_pruned_booleans();
+        stats_.rebalanced_unions = convert_solid_->num_rebalanced_unions();
+        stats_.deduplicated_solids = convert_solid_->num_deduplicated();
+        stats_.welded_vertices = convert_solid_->num_welded_vertices();
+        stats_.degenerate_facets = convert_solid_->num_degenerate_facets();
+        using Kind = Transformer::Kind;
+        auto const& kinds = convert_transform_->kind_counts();
+        stats_.distinct_transforms = convert_transform_->num_distinct();
+        stats_.identity_transforms = kinds[static_cast<int>(Kind::identity)];
+        stats_.translation_transforms
+            = kinds[static_cast<int>(Kind::translation)];
+        stats_.rotation_transforms = kinds[static_cast<int>(Kind::rotation)];
+        stats_.permutation_transforms = convert_transform_->num_permutations();
+        G4VG_LOG(debug) << "Conversion times [s]: discovery "
+                        << stats_.discovery_time << ", solids "
+                        << stats_.solid_time << ", placement "
+                        << stats_.placement_time << ", volume map "
+                        << stats_.volume_map_time;
+    }
+
+    if (options_.verify_samples > 0)
+    {
+        TraceSpan span(trace_.get(), "verify", "phase");
+        get_time = Stopwatch{};
+        SolidVerifier verify{
+            *convert_scale_, options_.verify_samples, options_.num_threads};
+        verify(convert_solid_->converted(), &stats_.solid_types);
+        stats_.verify_time = get_time();
+    }
+
+    if (options_.statistics)
+    {
+        stats_.memory = this->measure_memory(result);
+        std::size_t const end_rss = peak_rss();
+        stats_.memory.peak_rss_delta
+            = end_rss > start_rss ? end_rss - start_rss : 0;
+        result.stats = std::move(stats_);
+    }
+    else if (options_.verify_samples > 0)
+    {
+        // Return the verification summary even without other statistics
+        result.stats.solid_types = std::move(stats_.solid_types);
+        result.stats.verify_time = stats_.verify_time;
+    }
+
+    if (trace_)
+    {
+        trace_->write();
+        G4VG_LOG(info) << "Wrote conversion trace to "
+                       << options_.trace_file;
+    }
 
     G4VG_ENSURE(result.world);
     G4VG_ENSURE(!result.logical_volumes.empty());
@@ -279,93 +532,296 @@ auto Converter::operator()(arg_type g4world) -> result_type
     return result;
 }
 
+//---------------------------------------------------------------------------//
+/*!
+ * Estimate the memory used by the converted geometry and caches.
+ *
+ * Unplaced volumes are counted once even if they're shared. Logical volume
+ * sizes include their daughter lists, and placed volume sizes are reported by
+ * VecGeom.
+ */
+auto Converter::measure_memory(result_type const& result) const
+    -> Statistics::Memory
+{
+    Statistics::Memory memory;
+
+    std::unordered_set<vecgeom::VUnplacedVolume const*> unplaced;
+    auto add_unplaced = [&memory, &unplaced](
+                            vecgeom::VUnplacedVolume const* uv) {
+        if (uv && unplaced.insert(uv).second)
+        {
+            add_usage(
+                &memory.unplaced[TypeDemangler<vecgeom::VUnplacedVolume>{}(
+                    *uv)],
+                static_cast<std::size_t>(uv->MemorySize()));
+        }
+    };
+    auto lv_bytes = [](VGLogicalVolume const& lv) {
+        return sizeof(VGLogicalVolume)
+               + lv.GetDaughters().size()
+                     * sizeof(vecgeom::VPlacedVolume const*);
+    };
+
+    for (auto&& [g4lv, lv] : convert_lv_->converted())
+    {
+        add_usage(&memory.logical_volumes, lv_bytes(*lv));
+        add_unplaced(lv->GetUnplacedVolume());
+    }
+    for (auto const* pv : convert_solid_->temp_placed())
+    {
+        auto const* lv = pv->GetLogicalVolume();
+        add_usage(&memory.temp_logical_volumes, lv_bytes(*lv));
+        add_usage(&memory.temp_placed_volumes,
+                  static_cast<std::size_t>(pv->MemorySize()));
+        add_unplaced(lv->GetUnplacedVolume());
+    }
+    for (auto&& [g4solid, uv] : convert_solid_->converted())
+    {
+        add_unplaced(uv);
+    }
+
+    auto& geo_manager = vecgeom::GeoManager::Instance();
+    for (std::size_t id = 0; id != result.physical_volumes.size(); ++id)
+    {
+        if (!result.physical_volumes[id])
+        {
+            continue;
+        }
+        vecgeom::VPlacedVolume const* pv
+            = (id == result.world->id()) ? result.world
+                                         : geo_manager.FindPlacedVolume(id);
+        if (pv)
+        {
+            add_usage(&memory.placed_volumes,
+                      static_cast<std::size_t>(pv->MemorySize()));
+        }
+    }
+
+    memory.transforms = convert_transform_->memory_usage();
+    std::size_t const num_triangles = convert_solid_->num_triangles();
+    using Vertex = vecgeom::Vector3D<vecgeom::Precision>;
+    add_usage(&memory.tessellated_facets,
+              num_triangles * 3 * sizeof(Vertex),
+              num_triangles);
+
+    memory.solid_cache = hash_container_usage(convert_solid_->converted());
+    memory.lv_cache = container_usage(convert_lv_->converted());
+    memory.built_daughters = container_usage(built_daughters_);
+    for (auto const& usage : {container_usage(result.logical_volumes),
+                              container_usage(result.physical_volumes),
+                              container_usage(result.lv_index),
+                              container_usage(result.pv_index),
+                              container_usage(result.temp_lv_ids),
+                              container_usage(result.temp_pv_ids)})
+    {
+        add_usage(&memory.volume_maps, usage.bytes, usage.count);
+    }
+
+    return memory;
+}
+
 //---------------------------------------------------------------------------//
 //! \cond
+//! Volume whose daughters are being placed
+struct Converter::BuildFrame
+{
+    G4LogicalVolume const* g4lv{nullptr};
+    VGLogicalVolume* lv{nullptr};
+    std::size_t daughter{0};
+    VGLogicalVolume* daughter_lv{nullptr};
+    TraceSpan span;
+};
+
+//---------------------------------------------------------------------------//
 /*!
  * Convert a volume and its daughter volumes.
+ *
+ * The hierarchy is traversed depth-first with an explicit stack so that deep
+ * geometries can't overflow the call stack. As with a recursive traversal,
+ * the contents of each daughter volume are built before the daughter itself
+ * is placed, so VecGeom volume IDs are assigned in the same order.
+ */
+auto Converter::build_with_daughters(G4LogicalVolume const* world_g4lv)
+    -> VGLogicalVolume*
+{
+    G4VG_EXPECT(world_g4lv);
+
+    BuildStack stack;
+    VGLogicalVolume* world_lv = this->begin_build(*world_g4lv, &stack);
+
+    while (!stack.empty())
+    {
+        std::size_t const top = stack.size() - 1;
+        G4LogicalVolume const* mother_g4lv = stack[top].g4lv;
+        using size_type = decltype(mother_g4lv->GetNoDaughters());
+        auto const i = static_cast<size_type>(stack[top].daughter);
+        if (i == mother_g4lv->GetNoDaughters())
+        {
+            // All daughters have been placed
+            stack.pop_back();
+            continue;
+        }
+
+        G4VPhysicalVolume* g4pv = mother_g4lv->GetDaughter(i);
+        G4VG_ASSERT(g4pv);
+
+        if (!stack[top].daughter_lv)
+        {
+            // Build the daughter's contents before placing it
+            G4LogicalVolume const* daughter_g4lv = g4pv->GetLogicalVolume();
+            if (options_.reflection_factory)
+            {
+                if (auto const* unrefl_g4lv
+                    = get_constituent_lv(*daughter_g4lv))
+                {
+                    daughter_g4lv = unrefl_g4lv;
+                }
+            }
+            VGLogicalVolume* daughter_lv
+                = this->begin_build(*daughter_g4lv, &stack);
+            stack[top].daughter_lv = daughter_lv;
+            if (stack.size() - 1 != top)
+            {
+                // Daughter was pushed onto the stack
+                continue;
+            }
+        }
+
+        this->place_daughter(g4pv, stack[top].daughter_lv, stack[top].lv);
+        ++stack[top].daughter;
+        stack[top].daughter_lv = nullptr;
+    }
+
+    return world_lv;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Convert a volume and push it if its daughters need to be placed.
+ *
+ * Daughters are placed only the first time a volume is encountered, and not
+ * at all if the volume is a voxel grid or its daughters are pruned.
  */
-auto Converter::build_with_daughters(G4LogicalVolume const* mother_g4lv)
+auto Converter::begin_build(G4LogicalVolume const& g4lv, BuildStack* stack)
     -> VGLogicalVolume*
 {
-    G4VG_EXPECT(mother_g4lv);
+    G4VG_EXPECT(stack);
 
     if (G4VG_UNLIKELY(options_.verbose))
     {
-        std::clog << std::string(depth_, ' ') << "Converting "
-                  << mother_g4lv->GetName() << std::endl;
+        std::clog << std::string(stack->size(), ' ') << "Converting "
+                  << g4lv.GetName() << std::endl;
     }
 
     // Convert or get corresponding VecGeom volume
-    VGLogicalVolume* mother_lv = (*convert_lv_)(*mother_g4lv);
+    VGLogicalVolume* lv = (*convert_lv_)(g4lv);
 
-    if (auto [iter, inserted] = built_daughters_.insert(mother_lv); !inserted)
+    if (!built_daughters_.insert(lv))
     {
         // Daughters have already been built
-        return mother_lv;
+        return lv;
     }
 
-    ++depth_;
+    TraceSpan span(trace_.get(), g4lv.GetName(), "placement");
+    if (span)
+    {
+        span.arg("daughters", std::to_string(g4lv.GetNoDaughters()));
+    }
 
-    auto convert_daughter = [this](G4LogicalVolume const* g4lv) {
-        return this->build_with_daughters(g4lv);
-    };
+    if (convert_voxels_ && convert_voxels_->is_grid(g4lv))
+    {
+        // Describe the daughters as a voxel grid instead of placing them
+        auto grid = (*convert_voxels_)(g4lv);
+        grid.lv_id = lv->id();
+        voxel_grids_.push_back(std::move(grid));
+        return lv;
+    }
 
-    // Place daughter logical volumes in this mother
-    using size_type = decltype(mother_g4lv->GetNoDaughters());
-    for (size_type i = 0, imax = mother_g4lv->GetNoDaughters(); i != imax; ++i)
+    if (options_.prune_daughters && options_.prune_daughters(g4lv))
     {
-        // Get daughter volume
-        G4VPhysicalVolume* g4pv = mother_g4lv->GetDaughter(i);
-        G4VG_ASSERT(g4pv);
+        // Leave the volume empty
+        if (G4VG_UNLIKELY(options_.verbose))
+        {
+            std::clog << std::string(stack->size(), ' ')
+                      << "Pruned daughters of " << g4lv.GetName()
+                      << std::endl;
+        }
+        return lv;
+    }
 
-        DaughterPlacer place_daughter(convert_daughter,
-                                      options_.reflection_factory,
-                                      *convert_transform_,
-                                      &placed_volumes_,
-                                      g4pv->GetLogicalVolume(),
-                                      mother_lv);
+    // Keep the span open until the daughters are placed
+    stack->push_back({&g4lv, lv, 0, nullptr, std::move(span)});
+    return lv;
+}
 
-        switch (g4pv->VolumeType())
-        {
-            case EVolume::kNormal:
-                // Place daughter, accounting for reflection
-                place_daughter(g4pv);
-                break;
-            case EVolume::kReplica:
-                // Place daughter in each replicated location
-                place_daughter(g4pv, ReplicaUpdater{});
-                break;
-            case EVolume::kParameterised:
-                // Place each paramterized instance of the daughter
-                G4VG_ASSERT(g4pv->GetParameterisation());
-                if (auto* nested = dynamic_cast<G4VNestedParameterisation*>(
-                        g4pv->GetParameterisation()))
-                {
-                    G4VG_LOG(warning)
-                        << "Encountered nested parameterisation '"
-                        << TypeDemangler<G4VNestedParameterisation>{}(*nested)
-                        << "' for physical volume '" << g4pv->GetName()
-                        << "' (corresponding LV: "
-                        << PrintableLV{g4pv->GetLogicalVolume()} << "): "
-                        << "only one instance will be placed, and "
-                           "solid/material changes will be ignored";
-                    nested_.push_back(g4pv);
-                }
-                place_daughter(g4pv, ParamUpdater{g4pv->GetParameterisation()});
+//---------------------------------------------------------------------------//
+/*!
+ * Place a daughter whose contents have been built.
+ */
+void Converter::place_daughter(G4VPhysicalVolume* g4pv,
+                               VGLogicalVolume* daughter_lv,
+                               VGLogicalVolume* mother_lv)
+{
+    G4VG_EXPECT(g4pv);
+
+    DaughterPlacer place(options_,
+                         trace_.get(),
+                         *convert_transform_,
+                         &placed_volumes_,
+                         &pv_index_,
+                         g4pv->GetLogicalVolume(),
+                         daughter_lv,
+                         mother_lv);
+
+    switch (g4pv->VolumeType())
+    {
+        case EVolume::kNormal:
+            // Place daughter, accounting for reflection
+            place(g4pv);
+            break;
+        case EVolume::kReplica:
+            if (options_.compact_replicas)
+            {
+                // Place only the first copy and describe the others
+                ReplicaUpdater{}(0, g4pv);
+                g4pv->SetCopyNo(0);
+                auto const* vgpv = place(g4pv);
+                replicas_.push_back(
+                    make_replica(*convert_scale_, *g4pv, vgpv->id()));
+                stats_.replica_copies += 1;
                 break;
-            default:
-                G4VG_LOG(error)
-                    << "Unsupported custom placement type '"
-                    << TypeDemangler<G4VPhysicalVolume>{}(*g4pv)
+            }
+            // Place daughter in each replicated location
+            place(g4pv, ReplicaUpdater{});
+            stats_.replica_copies += g4pv->GetMultiplicity();
+            break;
+        case EVolume::kParameterised:
+            // Place each paramterized instance of the daughter
+            G4VG_ASSERT(g4pv->GetParameterisation());
+            if (auto* nested = dynamic_cast<G4VNestedParameterisation*>(
+                    g4pv->GetParameterisation()))
+            {
+                G4VG_LOG(warning)
+                    << "Encountered nested parameterisation '"
+                    << TypeDemangler<G4VNestedParameterisation>{}(*nested)
                     << "' for physical volume '" << g4pv->GetName()
                     << "' (corresponding LV: "
-                    << PrintableLV{g4pv->GetLogicalVolume()} << ")";
-        }
+                    << PrintableLV{g4pv->GetLogicalVolume()} << "): "
+                    << "only one instance will be placed, and "
+                       "solid/material changes will be ignored";
+                nested_.push_back(g4pv);
+            }
+            place(g4pv, ParamUpdater{g4pv->GetParameterisation()});
+            stats_.param_copies += g4pv->GetMultiplicity();
+            break;
+        default:
+            G4VG_LOG(error)
+                << "Unsupported custom placement type '"
+                << TypeDemangler<G4VPhysicalVolume>{}(*g4pv)
+                << "' for physical volume '" << g4pv->GetName()
+                << "' (corresponding LV: "
+                << PrintableLV{g4pv->GetLogicalVolume()} << ")";
     }
-
-    --depth_;
-
-    return mother_lv;
 }
 //! \endcond
 
@@ -7,10 +7,10 @@
 #pragma once
 
 #include <memory>
-#include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
 #include "G4VG.hh"
+#include "InstanceMap.hh"
 
 namespace g4vg
 {
@@ -19,6 +19,8 @@ class Scaler;
 class Transformer;
 class SolidConverter;
 class LogicalVolumeConverter;
+class TraceWriter;
+class VoxelGridConverter;
 
 //---------------------------------------------------------------------------//
 /*!
@@ -50,18 +52,37 @@ class Converter
   private:
     using VGLogicalVolume = vecgeom::LogicalVolume;
 
+    struct BuildFrame;
+    using BuildStack = std::vector<BuildFrame>;
+
     Options options_;
-    int depth_{0};
 
     std::unique_ptr<Scaler> convert_scale_;
     std::unique_ptr<Transformer> convert_transform_;
+    std::unique_ptr<TraceWriter> trace_;
     std::unique_ptr<SolidConverter> convert_solid_;
     std::unique_ptr<LogicalVolumeConverter> convert_lv_;
-    std::unordered_set<VGLogicalVolume const*> built_daughters_;
+    std::unique_ptr<VoxelGridConverter> convert_voxels_;
+    InstanceSet<VGLogicalVolume const*> built_daughters_;
     VecPv placed_volumes_;
+    result_type::VecPvIndex pv_index_;
     result_type::VecPv nested_;
+    result_type::VecReplica replicas_;
+    result_type::VecVoxelGrid voxel_grids_;
+    Statistics stats_;
+
+    VGLogicalVolume* build_with_daughters(G4LogicalVolume const* world_g4lv);
+
+    // Convert a volume and push it if its daughters need to be placed
+    VGLogicalVolume* begin_build(G4LogicalVolume const& g4lv, BuildStack*);
+
+    // Place a daughter whose contents have been built
+    void place_daughter(G4VPhysicalVolume* g4pv,
+                        VGLogicalVolume* daughter_lv,
+                        VGLogicalVolume* mother_lv);
 
-    VGLogicalVolume* build_with_daughters(G4LogicalVolume const* mother_g4lv);
+    // Estimate the memory used by the converted geometry and caches
+    Statistics::Memory measure_memory(result_type const& result) const;
 };
 
 //---------------------------------------------------------------------------//
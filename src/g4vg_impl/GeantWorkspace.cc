@@ -0,0 +1,61 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/GeantWorkspace.cc
+//---------------------------------------------------------------------------//
+#include "GeantWorkspace.hh"
+
+#include <G4GeometryWorkspace.hh>
+#include <G4GlobalConfig.hh>
+#include <G4SolidsWorkspace.hh>
+
+#include "Logger.hh"
+#include "ParallelFor.hh"
+
+namespace g4vg
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Create and use new workspaces.
+ */
+GeantWorkspace::GeantWorkspace()
+{
+    G4GeometryWorkspace::GetPool()->CreateAndUseWorkspace();
+    G4SolidsWorkspace::GetPool()->CreateAndUseWorkspace();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Clean up and destroy the workspaces.
+ */
+GeantWorkspace::~GeantWorkspace()
+{
+    G4SolidsWorkspace::GetPool()->CleanUpAndDestroyAllWorkspaces();
+    G4GeometryWorkspace::GetPool()->CleanUpAndDestroyAllWorkspaces();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get the number of threads that can call into Geant4 concurrently.
+ *
+ * Without \c G4MULTITHREADED , per-thread geometry and solid data are shared
+ * by all threads, so the task falls back to a single thread.
+ */
+unsigned int resolve_geant_threads(unsigned int requested,
+                                   [[maybe_unused]] char const* task)
+{
+    unsigned int num_threads = resolve_num_threads(requested);
+#ifndef G4MULTITHREADED
+    if (num_threads > 1)
+    {
+        G4VG_LOG(warning) << "Geant4 is not multithreaded: " << task
+                          << " on a single thread";
+        num_threads = 1;
+    }
+#endif
+    return num_threads;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
@@ -0,0 +1,45 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/GeantWorkspace.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+namespace g4vg
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Use new Geant4 geometry and solid workspaces on a non-Geant4 thread.
+ *
+ * Geant4 keeps per-thread data in workspaces: the state of replicated and
+ * parameterised volumes, and scratch data of some solids (such as the phi
+ * caches of polycones and polyhedra). A thread that wasn't created by Geant4
+ * has no workspace, so it must create one before calling into the geometry.
+ * The workspaces are destroyed when this object goes out of scope.
+ *
+ * This should be constructed only on spawned worker threads, since the
+ * calling thread already uses the master or worker workspace.
+ */
+class GeantWorkspace
+{
+  public:
+    // Create and use new workspaces
+    GeantWorkspace();
+
+    // Clean up and destroy the workspaces
+    ~GeantWorkspace();
+
+    //!@{
+    //! Prevent copying and moving
+    GeantWorkspace(GeantWorkspace const&) = delete;
+    GeantWorkspace& operator=(GeantWorkspace const&) = delete;
+    //!@}
+};
+
+//---------------------------------------------------------------------------//
+// Get the number of threads that can call into Geant4 concurrently
+unsigned int resolve_geant_threads(unsigned int requested, char const* task);
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
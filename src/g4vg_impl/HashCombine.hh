@@ -0,0 +1,27 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/HashCombine.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace g4vg
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Mix the hash of a value into a running hash.
+ *
+ * This is the same combination as \c boost::hash_combine .
+ */
+template<class T>
+inline void hash_combine(std::size_t& seed, T const& value)
+{
+    seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
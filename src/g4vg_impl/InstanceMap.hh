@@ -0,0 +1,251 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/InstanceMap.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "Assert.hh"
+#include "PointerMap.hh"
+
+namespace g4vg
+{
+//---------------------------------------------------------------------------//
+// FREE FUNCTIONS
+//---------------------------------------------------------------------------//
+//! Get the sequential instance ID of a Geant4 volume
+template<class T>
+auto instance_id(T const& obj)
+    -> decltype(static_cast<std::size_t>(obj.GetInstanceID()))
+{
+    return static_cast<std::size_t>(obj.GetInstanceID());
+}
+
+//! Get the sequential ID of a VecGeom volume
+template<class T>
+auto instance_id(T const& obj) -> decltype(static_cast<std::size_t>(obj.id()))
+{
+    return static_cast<std::size_t>(obj.id());
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Map from a volume to a value, stored densely by the volume's instance ID.
+ *
+ * Geant4 logical and physical volumes, and VecGeom volumes, are numbered
+ * sequentially as they're constructed, so a lookup is a single array access
+ * with no hashing. The slot array grows on demand to the largest ID inserted;
+ * its size is thus bounded by the number of volumes ever created in the
+ * process rather than the number of entries.
+ *
+ * Entries can't be erased. Inserting may reallocate the slots, which
+ * invalidates all iterators and references. Iteration is in ID order.
+ */
+template<class K, class V>
+class InstanceMap
+{
+    using Traits = detail::PointerMapTraits<K, V>;
+
+  public:
+    //!@{
+    //! \name Type aliases
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+    using size_type = std::size_t;
+    using iterator = detail::SlotIterator<Traits, value_type>;
+    using const_iterator = detail::SlotIterator<Traits, value_type const>;
+    //!@}
+
+  public:
+    //// ACCESSORS ////
+
+    //! Number of entries
+    size_type size() const { return size_; }
+
+    //! Whether no entries are present
+    bool empty() const { return size_ == 0; }
+
+    //! Number of allocated slots
+    size_type bucket_count() const { return slots_.size(); }
+
+    //! Size of a single slot in bytes
+    static constexpr size_type slot_size() { return sizeof(value_type); }
+
+    //! Find an entry
+    iterator find(key_type key)
+    {
+        size_type id = this->find_slot(key);
+        return id != slots_.size() ? this->make_iter(id) : this->end();
+    }
+
+    //! Find an entry
+    const_iterator find(key_type key) const
+    {
+        size_type id = this->find_slot(key);
+        return id != slots_.size() ? this->make_iter(id) : this->end();
+    }
+
+    //! Whether the key is present (zero or one)
+    size_type count(key_type key) const
+    {
+        return this->find_slot(key) != slots_.size() ? 1 : 0;
+    }
+
+    //!@{
+    //! Iterate over entries
+    iterator begin() { return this->make_iter(0); }
+    iterator end() { return this->make_iter(slots_.size()); }
+    const_iterator begin() const { return this->make_iter(0); }
+    const_iterator end() const { return this->make_iter(slots_.size()); }
+    //!@}
+
+    //// MUTATORS ////
+
+    // Insert an entry if its key is not present
+    inline std::pair<iterator, bool> insert(value_type value);
+
+    //! Allocate slots for IDs less than the given value
+    void reserve(size_type num_ids)
+    {
+        if (num_ids > slots_.size())
+        {
+            slots_.resize(num_ids);
+        }
+    }
+
+  private:
+    std::vector<value_type> slots_;
+    size_type size_{0};
+
+    // Index of the slot holding the key, or the slot count if absent
+    size_type find_slot(key_type key) const
+    {
+        G4VG_EXPECT(key);
+        size_type id = instance_id(*key);
+        if (id < slots_.size() && slots_[id].first)
+        {
+            G4VG_ASSERT(slots_[id].first == key);
+            return id;
+        }
+        return slots_.size();
+    }
+
+    iterator make_iter(size_type i)
+    {
+        auto* data = slots_.data();
+        return {data + i, data + slots_.size()};
+    }
+    const_iterator make_iter(size_type i) const
+    {
+        auto const* data = slots_.data();
+        return {data + i, data + slots_.size()};
+    }
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Set of volumes, stored as a bitset indexed by the volume's instance ID.
+ */
+template<class K>
+class InstanceSet
+{
+  public:
+    //!@{
+    //! \name Type aliases
+    using key_type = K;
+    using size_type = std::size_t;
+    //!@}
+
+  public:
+    //// ACCESSORS ////
+
+    //! Number of entries
+    size_type size() const { return size_; }
+
+    //! Whether no entries are present
+    bool empty() const { return size_ == 0; }
+
+    //! Number of allocated bits
+    size_type bucket_count() const { return bits_.size(); }
+
+    //! Whether the key is present (zero or one)
+    size_type count(key_type key) const
+    {
+        G4VG_EXPECT(key);
+        size_type id = instance_id(*key);
+        return id < bits_.size() && bits_[id] ? 1 : 0;
+    }
+
+    //// MUTATORS ////
+
+    //! Insert a key, returning whether it was not already present
+    bool insert(key_type key)
+    {
+        G4VG_EXPECT(key);
+        size_type id = instance_id(*key);
+        if (id >= bits_.size())
+        {
+            bits_.resize(std::max(id + 1, 2 * bits_.size()));
+        }
+        if (bits_[id])
+        {
+            return false;
+        }
+        bits_[id] = true;
+        ++size_;
+        return true;
+    }
+
+    //! Allocate bits for IDs less than the given value
+    void reserve(size_type num_ids)
+    {
+        if (num_ids > bits_.size())
+        {
+            bits_.resize(num_ids);
+        }
+    }
+
+  private:
+    std::vector<bool> bits_;
+    size_type size_{0};
+};
+
+//---------------------------------------------------------------------------//
+// INLINE DEFINITIONS
+//---------------------------------------------------------------------------//
+/*!
+ * Insert an entry if its key is not present.
+ *
+ * The result is the iterator to the entry with the key and whether the entry
+ * was inserted, as with \c std::unordered_map::insert .
+ */
+template<class K, class V>
+auto InstanceMap<K, V>::insert(value_type value) -> std::pair<iterator, bool>
+{
+    G4VG_EXPECT(value.first);
+    size_type id = instance_id(*value.first);
+    if (id >= slots_.size())
+    {
+        slots_.resize(std::max(id + 1, 2 * slots_.size()));
+    }
+
+    value_type& slot = slots_[id];
+    if (slot.first)
+    {
+        G4VG_ASSERT(slot.first == value.first);
+        return {this->make_iter(id), false};
+    }
+    slot = std::move(value);
+    ++size_;
+    return {this->make_iter(id), true};
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
@@ -12,6 +12,7 @@
 #include <VecGeom/volumes/LogicalVolume.h>
 #include <VecGeom/volumes/UnplacedVolume.h>
 
+#include "AbsorbedDisplacement.hh"
 #include "Assert.hh"
 #include "GDMLUtils.hh"
 #include "Logger.hh"
@@ -22,11 +23,14 @@ namespace g4vg
 {
 //---------------------------------------------------------------------------//
 /*!
- * Construct with solid conversion helper.
+ * Construct with solid conversion helper and conversion options.
  */
 LogicalVolumeConverter::LogicalVolumeConverter(SolidConverter& convert_solid,
-                                               bool append_pointers)
-    : convert_solid_(convert_solid), append_pointers_(append_pointers)
+                                               Options const& options)
+    : convert_solid_(convert_solid)
+    , append_pointers_(options.append_pointers)
+    , absorb_displaced_(options.absorb_displaced)
+    , reflection_factory_(options.reflection_factory)
 {
     G4VG_EXPECT(!vecgeom::GeoManager::Instance().IsClosed());
 }
@@ -39,15 +43,16 @@ LogicalVolumeConverter::LogicalVolumeConverter(SolidConverter& convert_solid,
  */
 auto LogicalVolumeConverter::operator()(arg_type lv) -> result_type
 {
-    auto [cache_iter, inserted] = cache_.insert({&lv, nullptr});
-    if (inserted)
+    if (auto iter = cache_.find(&lv); iter != cache_.end())
     {
-        // First time converting the volume
-        cache_iter->second = this->construct_base(lv);
+        return iter->second;
     }
 
-    G4VG_ENSURE(cache_iter->second);
-    return cache_iter->second;
+    // First time converting the volume
+    result_type result = this->construct_base(lv);
+    G4VG_ENSURE(result);
+    cache_.insert({&lv, result});
+    return result;
 }
 
 //---------------------------------------------------------------------------//
@@ -72,21 +77,33 @@ auto LogicalVolumeConverter::make_volume_map() const -> VecLv
 //---------------------------------------------------------------------------//
 /*!
  * Convert the raw logical volume from geant4 to vecgeom.
+ *
+ * If the volume's displacement is absorbed into its placements, the shape is
+ * the underlying undisplaced solid.
  */
 auto LogicalVolumeConverter::construct_base(arg_type g4lv) -> result_type
 {
+    G4VSolid const* solid = g4lv.GetSolid();
+    if (absorb_displaced_)
+    {
+        if (auto absorbed
+            = find_absorbed_displacement(g4lv, reflection_factory_))
+        {
+            solid = absorbed.solid;
+        }
+    }
+
     vecgeom::VUnplacedVolume const* shape = nullptr;
     try
     {
-        shape = convert_solid_(*g4lv.GetSolid());
+        shape = convert_solid_(*solid);
     }
     catch (g4vg::RuntimeError const& e)
     {
         G4VG_LOG(error) << "Failed to convert solid type '"
-                        << g4lv.GetSolid()->GetEntityType() << "' named '"
-                        << g4lv.GetSolid()->GetName()
-                        << "': " << e.what_minimal();
-        shape = this->convert_solid_.to_sphere(*g4lv.GetSolid());
+                        << solid->GetEntityType() << "' named '"
+                        << solid->GetName() << "': " << e.what_minimal();
+        shape = this->convert_solid_.to_sphere(*solid);
         G4VG_LOG(warning)
             << "Replaced unknown solid with sphere with capacity "
             << shape->Capacity() << " [len^3]";
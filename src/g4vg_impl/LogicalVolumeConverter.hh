@@ -6,9 +6,11 @@
 //---------------------------------------------------------------------------//
 #pragma once
 
-#include <unordered_map>
 #include <vector>
 
+#include "G4VG.hh"
+#include "InstanceMap.hh"
+
 //---------------------------------------------------------------------------//
 // Forward declarations
 //---------------------------------------------------------------------------//
@@ -44,10 +46,12 @@ class LogicalVolumeConverter
     using arg_type = G4LogicalVolume const&;
     using result_type = vecgeom::LogicalVolume*;
     using VecLv = std::vector<G4LogicalVolume const*>;
+    using MapLv = InstanceMap<G4LogicalVolume const*, result_type>;
     //!@}
 
   public:
-    LogicalVolumeConverter(SolidConverter& convert_solid, bool append_pointers);
+    LogicalVolumeConverter(SolidConverter& convert_solid,
+                           Options const& options);
 
     // Convert a volume
     result_type operator()(arg_type);
@@ -55,12 +59,17 @@ class LogicalVolumeConverter
     // Construct a mapping from G4 logical volume to logical volume ID
     VecLv make_volume_map() const;
 
+    //! Converted volumes
+    MapLv const& converted() const { return cache_; }
+
   private:
     //// DATA ////
 
     SolidConverter& convert_solid_;
     bool append_pointers_{false};
-    std::unordered_map<G4LogicalVolume const*, result_type> cache_;
+    bool absorb_displaced_{false};
+    bool reflection_factory_{false};
+    MapLv cache_;
 
     //// HELPER FUNCTIONS ////
 
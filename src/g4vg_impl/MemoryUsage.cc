@@ -0,0 +1,45 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/MemoryUsage.cc
+//---------------------------------------------------------------------------//
+#include "MemoryUsage.hh"
+
+#if defined(__unix__) || defined(__APPLE__)
+#    include <sys/resource.h>
+#    define G4VG_HAVE_GETRUSAGE 1
+#else
+#    define G4VG_HAVE_GETRUSAGE 0
+#endif
+
+namespace g4vg
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Get the peak resident set size of this process in bytes.
+ *
+ * This returns zero on platforms without \c getrusage .
+ */
+std::size_t peak_rss()
+{
+#if G4VG_HAVE_GETRUSAGE
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#    ifdef __APPLE__
+    // macOS reports bytes
+    return static_cast<std::size_t>(usage.ru_maxrss);
+#    else
+    // Linux reports kilobytes
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#    endif
+#else
+    return 0;
+#endif
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
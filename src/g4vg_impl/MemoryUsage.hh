@@ -0,0 +1,99 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/MemoryUsage.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <climits>
+#include <cstddef>
+#include <vector>
+
+#include "G4VG.hh"
+#include "InstanceMap.hh"
+#include "PointerMap.hh"
+
+namespace g4vg
+{
+//---------------------------------------------------------------------------//
+// FREE FUNCTIONS
+//---------------------------------------------------------------------------//
+// Get the peak resident set size of this process in bytes (0 if unknown)
+std::size_t peak_rss();
+
+//---------------------------------------------------------------------------//
+//! Estimate the heap usage of a vector
+template<class T>
+Statistics::MemoryUsage container_usage(std::vector<T> const& v)
+{
+    Statistics::MemoryUsage result;
+    result.count = v.size();
+    result.bytes = v.capacity() * sizeof(T);
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+//! Estimate the heap usage of a map indexed by instance ID
+template<class K, class V>
+Statistics::MemoryUsage container_usage(InstanceMap<K, V> const& m)
+{
+    Statistics::MemoryUsage result;
+    result.count = m.size();
+    result.bytes = m.bucket_count() * m.slot_size();
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+//! Estimate the heap usage of a bitset indexed by instance ID
+template<class K>
+Statistics::MemoryUsage container_usage(InstanceSet<K> const& s)
+{
+    Statistics::MemoryUsage result;
+    result.count = s.size();
+    result.bytes = (s.bucket_count() + CHAR_BIT - 1) / CHAR_BIT;
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Estimate the heap usage of an unordered map or set.
+ *
+ * Each element is assumed to be allocated in a node with a "next" pointer
+ * and a cached hash, and each bucket is a pointer.
+ */
+template<class C>
+Statistics::MemoryUsage hash_container_usage(C const& c)
+{
+    Statistics::MemoryUsage result;
+    result.count = c.size();
+    result.bytes
+        = c.size()
+              * (sizeof(typename C::value_type) + sizeof(void*)
+                 + sizeof(std::size_t))
+          + c.bucket_count() * sizeof(void*);
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+//! Estimate the heap usage of a flat pointer-keyed map
+template<class K, class V>
+Statistics::MemoryUsage hash_container_usage(PointerMap<K, V> const& m)
+{
+    Statistics::MemoryUsage result;
+    result.count = m.size();
+    result.bytes = m.bucket_count() * m.slot_size();
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+//! Add an object of the given size to a usage tally
+inline void
+add_usage(Statistics::MemoryUsage* usage, std::size_t bytes, std::size_t n = 1)
+{
+    usage->count += n;
+    usage->bytes += bytes;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
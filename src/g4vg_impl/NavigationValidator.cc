@@ -0,0 +1,437 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/NavigationValidator.cc
+//---------------------------------------------------------------------------//
+#include "NavigationValidator.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <G4GeometryManager.hh>
+#include <G4LogicalVolume.hh>
+#include <G4Navigator.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4PhysicalConstants.hh>
+#include <G4VSolid.hh>
+#include <VecGeom/base/Global.h>
+#include <VecGeom/management/GeoManager.h>
+#include <VecGeom/navigation/GlobalLocator.h>
+#include <VecGeom/navigation/NavigationState.h>
+#include <VecGeom/navigation/VNavigator.h>
+#include <VecGeom/volumes/LogicalVolume.h>
+#include <VecGeom/volumes/PlacedVolume.h>
+
+#include "Assert.hh"
+#include "GeantWorkspace.hh"
+#include "Logger.hh"
+#include "ParallelFor.hh"
+
+namespace g4vg
+{
+namespace
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Generate reproducible random numbers from a seed and index.
+ *
+ * This uses the SplitMix64 algorithm, which is cheap to seed for every ray.
+ */
+class SplitMix
+{
+  public:
+    SplitMix(std::uint64_t seed, std::uint64_t index)
+        : state_{seed ^ (index * 0x9e3779b97f4a7c15ull)}
+    {
+    }
+
+    //! Sample a uniform number in [0, 1)
+    double operator()()
+    {
+        std::uint64_t z = (state_ += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        z ^= z >> 31;
+        return static_cast<double>(z >> 11) * 0x1.0p-53;
+    }
+
+  private:
+    std::uint64_t state_;
+};
+
+//---------------------------------------------------------------------------//
+//! Whether a step length is effectively infinite
+bool is_infinite(double step)
+{
+    return !(step < 1e20);
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace
+
+//---------------------------------------------------------------------------//
+//! Location and first mismatch of a single ray
+struct NavigationValidator::RayResult
+{
+    std::size_t num_steps{0};
+    bool traced{false};
+    bool volume_mismatch{false};
+    bool step_mismatch{false};
+    bool truncated{false};
+    Validation::Mismatch mismatch;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Locate and step with a Geant4 navigator.
+ */
+class NavigationValidator::G4Tracer
+{
+  public:
+    explicit G4Tracer(G4VPhysicalVolume* world)
+    {
+        navi_.SetWorldVolume(world);
+    }
+
+    //! Locate a new track
+    G4VPhysicalVolume const*
+    locate(G4ThreeVector const& pos, G4ThreeVector const& dir)
+    {
+        return navi_.LocateGlobalPointAndSetup(
+            pos, &dir, /* relative = */ false, /* ignore_dir = */ false);
+    }
+
+    //! Find the distance to the next boundary
+    double step(G4ThreeVector const& pos, G4ThreeVector const& dir)
+    {
+        double safety{0};
+        return navi_.ComputeStep(pos, dir, kInfinity, safety);
+    }
+
+    //! Relocate after moving to a boundary
+    G4VPhysicalVolume const*
+    cross(G4ThreeVector const& pos, G4ThreeVector const& dir)
+    {
+        navi_.SetGeometricallyLimitedStep();
+        return navi_.LocateGlobalPointAndSetup(
+            pos, &dir, /* relative = */ true, /* ignore_dir = */ false);
+    }
+
+  private:
+    G4Navigator navi_;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Locate and step with the VecGeom navigators of the closed geometry.
+ *
+ * Each step uses the navigator configured for the current logical volume
+ * (e.g., the BVH navigator if the application set it up), which also
+ * relocates the navigation state after crossing the boundary. The state is
+ * thus carried from step to step as in a transport loop.
+ */
+class NavigationValidator::VgTracer
+{
+  public:
+    using VPlacedVolume = vecgeom::VPlacedVolume;
+    using Real3 = vecgeom::Vector3D<vecgeom::Precision>;
+
+    explicit VgTracer(VPlacedVolume const* world)
+        : world_{world}, state_{make_state()}, next_state_{make_state()}
+    {
+        G4VG_EXPECT(world_);
+    }
+
+    //! Locate a new track, returning null if outside the world
+    VPlacedVolume const* locate(Real3 const& pos)
+    {
+        state_->Clear();
+        vecgeom::GlobalLocator::LocateGlobalPoint(
+            world_, pos, *state_, /* top = */ true);
+        return this->volume();
+    }
+
+    //! Find the distance to the next boundary and move the state across it
+    double step(Real3 const& pos, Real3 const& dir)
+    {
+        G4VG_EXPECT(this->volume());
+        auto const* navi = this->volume()->GetLogicalVolume()->GetNavigator();
+        G4VG_ASSERT(navi);
+        double result = navi->ComputeStepAndPropagatedState(
+            pos, dir, vecgeom::kInfLength, *state_, *next_state_);
+        std::swap(state_, next_state_);
+        return result;
+    }
+
+    //! Current volume, or null if outside the world
+    VPlacedVolume const* volume() const
+    {
+        return state_->IsOutside() ? nullptr : state_->Top();
+    }
+
+  private:
+    struct StateDeleter
+    {
+        void operator()(vecgeom::NavigationState* state) const
+        {
+            vecgeom::NavigationState::ReleaseInstance(state);
+        }
+    };
+    using UPState = std::unique_ptr<vecgeom::NavigationState, StateDeleter>;
+
+    VPlacedVolume const* world_;
+    UPState state_;
+    UPState next_state_;
+
+    static UPState make_state()
+    {
+        return UPState{vecgeom::NavigationState::MakeInstance(
+            vecgeom::GeoManager::Instance().getMaxDepth())};
+    }
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Construct with converted geometry and options.
+ */
+NavigationValidator::NavigationValidator(
+    Converted const& converted,
+    Options const& options,
+    ValidateOptions const& validate_options)
+    : converted_{converted}, scale_{options.scale}, options_{validate_options}
+{
+    G4VG_EXPECT(converted_.world);
+    G4VG_EXPECT(converted_.world->id() < converted_.physical_volumes.size());
+    auto const* g4world = converted_.physical_volumes[converted_.world->id()];
+    G4VG_EXPECT(g4world);
+    G4VG_VALIDATE(!g4world->GetMotherLogical(),
+                  << "navigation can only be validated for a converted world "
+                     "(not a subtree rooted at '"
+                  << g4world->GetName() << "')");
+    auto const& vg_manager = vecgeom::GeoManager::Instance();
+    G4VG_VALIDATE(vg_manager.IsClosed()
+                      && vg_manager.GetWorld() == converted_.world,
+                  << "the converted VecGeom world must be closed (with "
+                     "GeoManager::SetWorldAndClose) before validating "
+                     "navigation");
+    G4VG_VALIDATE(options_.tolerance > 0,
+                  << "invalid step tolerance " << options_.tolerance);
+
+    g4world->GetLogicalVolume()->GetSolid()->BoundingLimits(lower_, upper_);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Trace all rays.
+ *
+ * The Geant4 geometry is closed (optimized) for the duration of the
+ * validation if it isn't already.
+ */
+auto NavigationValidator::operator()() const -> result_type
+{
+    auto* geo_manager = G4GeometryManager::GetInstance();
+    bool const was_closed = geo_manager->IsGeometryClosed();
+    if (!was_closed)
+    {
+        geo_manager->CloseGeometry(/* optimise = */ true);
+    }
+
+    // Replica and parameterisation state is thread-local
+    unsigned int const num_threads
+        = resolve_geant_threads(options_.num_threads, "validating navigation");
+
+    // Split the rays into one contiguous chunk per thread
+    std::vector<RayResult> rays(options_.num_rays);
+    std::size_t const num_chunks = std::max<std::size_t>(
+        std::min<std::size_t>(num_threads, rays.size()), 1);
+    parallel_for_scoped<GeantWorkspace>(
+        num_chunks, num_threads, [&](std::size_t chunk) {
+            std::size_t begin = chunk * rays.size() / num_chunks;
+            std::size_t end = (chunk + 1) * rays.size() / num_chunks;
+            this->trace_range(begin, end, rays.data());
+        });
+
+    if (!was_closed)
+    {
+        geo_manager->OpenGeometry();
+    }
+
+    // Summarize
+    result_type result;
+    for (RayResult const& r : rays)
+    {
+        if (!r.traced)
+        {
+            continue;
+        }
+        ++result.num_rays;
+        result.num_steps += r.num_steps;
+        result.volume_mismatches += r.volume_mismatch;
+        result.step_mismatches += r.step_mismatch;
+        result.truncated += r.truncated;
+        if ((r.volume_mismatch || r.step_mismatch)
+            && result.mismatches.size() < options_.max_mismatches)
+        {
+            result.mismatches.push_back(r.mismatch);
+        }
+    }
+
+    if (result.volume_mismatches + result.step_mismatches > 0)
+    {
+        G4VG_LOG(warning) << "Navigation differs along "
+                          << result.volume_mismatches << " (volume) and "
+                          << result.step_mismatches << " (step length) of "
+                          << result.num_rays << " rays";
+    }
+    else
+    {
+        G4VG_LOG(info) << "Navigation agrees along " << result.num_rays
+                       << " rays (" << result.num_steps << " steps)";
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Trace a contiguous range of rays on the current thread.
+ */
+void NavigationValidator::trace_range(std::size_t begin,
+                                      std::size_t end,
+                                      RayResult* results) const
+{
+    auto* g4world = const_cast<G4VPhysicalVolume*>(
+        converted_.physical_volumes[converted_.world->id()]);
+    G4Tracer g4_tracer{g4world};
+    VgTracer vg_tracer{converted_.world};
+    for (std::size_t i = begin; i != end; ++i)
+    {
+        results[i] = this->trace(i, g4_tracer, vg_tracer);
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Trace a single ray.
+ */
+auto NavigationValidator::trace(std::size_t ray,
+                                G4Tracer& g4_tracer,
+                                VgTracer& vg_tracer) const -> RayResult
+{
+    // Sample an origin in the world's bounding box and an isotropic direction
+    SplitMix rng{options_.seed, ray};
+    G4ThreeVector pos;
+    for (int ax = 0; ax < 3; ++ax)
+    {
+        pos[ax] = lower_[ax] + rng() * (upper_[ax] - lower_[ax]);
+    }
+    double const costheta = 2 * rng() - 1;
+    double const sintheta = std::sqrt(1 - costheta * costheta);
+    double const phi = 2 * CLHEP::pi * rng();
+    G4ThreeVector const dir{
+        sintheta * std::cos(phi), sintheta * std::sin(phi), costheta};
+
+    // Compare the Geant4 state with the VecGeom state
+    using Real3 = VgTracer::Real3;
+    using VPlacedVolume = VgTracer::VPlacedVolume;
+    Real3 const vg_dir{dir.x(), dir.y(), dir.z()};
+    auto to_vg = [this](G4ThreeVector const& p) {
+        return Real3{p.x() * scale_, p.y() * scale_, p.z() * scale_};
+    };
+
+    RayResult result;
+    auto record = [&](int step,
+                      G4ThreeVector const& start,
+                      G4VPhysicalVolume const* g4pv,
+                      VPlacedVolume const* vgpv,
+                      double g4_step,
+                      double vg_step) {
+        auto& m = result.mismatch;
+        m.ray = ray;
+        m.step = step;
+        m.pos = {{start.x(), start.y(), start.z()}};
+        m.dir = {{dir.x(), dir.y(), dir.z()}};
+        m.g4_pv = g4pv;
+        m.g4_copy_no = g4pv ? g4pv->GetCopyNo() : -1;
+        if (vgpv)
+        {
+            G4VG_ASSERT(vgpv->id() < converted_.physical_volumes.size());
+            m.vg_pv = converted_.physical_volumes[vgpv->id()];
+            m.vg_copy_no = vgpv->GetCopyNo();
+        }
+        m.g4_step = g4_step;
+        m.vg_step = vg_step;
+    };
+    auto same_volume = [&](G4VPhysicalVolume const* g4pv,
+                           VPlacedVolume const* vgpv) {
+        if (!g4pv || !vgpv)
+        {
+            return !g4pv && !vgpv;
+        }
+        return converted_.physical_volumes[vgpv->id()] == g4pv
+               && vgpv->GetCopyNo() == g4pv->GetCopyNo();
+    };
+
+    G4VPhysicalVolume const* g4pv = g4_tracer.locate(pos, dir);
+    VPlacedVolume const* vgpv = vg_tracer.locate(to_vg(pos));
+    if (!g4pv && !vgpv)
+    {
+        // Ray starts outside the world
+        return result;
+    }
+    result.traced = true;
+    if (!same_volume(g4pv, vgpv))
+    {
+        result.volume_mismatch = true;
+        record(0, pos, g4pv, vgpv, 0, 0);
+        return result;
+    }
+
+    for (int step = 1; step <= options_.max_steps; ++step)
+    {
+        G4ThreeVector const start = pos;
+        double const g4_step = g4_tracer.step(pos, dir);
+        double const vg_step = vg_tracer.step(to_vg(start), vg_dir) / scale_;
+
+        bool const g4_exits = is_infinite(g4_step);
+        bool const vg_exits = is_infinite(vg_step);
+        if (g4_exits != vg_exits
+            || (!g4_exits
+                && std::fabs(g4_step - vg_step)
+                       > options_.tolerance * std::max(1.0, g4_step)))
+        {
+            result.step_mismatch = true;
+            record(step, start, g4pv, vgpv, g4_step, vg_step);
+            return result;
+        }
+        if (g4_exits)
+        {
+            // Both left the world
+            return result;
+        }
+
+        pos += g4_step * dir;
+        g4pv = g4_tracer.cross(pos, dir);
+        vgpv = vg_tracer.volume();
+        if (!same_volume(g4pv, vgpv))
+        {
+            result.volume_mismatch = true;
+            record(step, start, g4pv, vgpv, g4_step, vg_step);
+            return result;
+        }
+        ++result.num_steps;
+        if (!g4pv)
+        {
+            // Left the world
+            return result;
+        }
+    }
+    result.truncated = true;
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
@@ -0,0 +1,72 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/NavigationValidator.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <cstddef>
+#include <G4ThreeVector.hh>
+
+#include "G4VG.hh"
+
+namespace g4vg
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Trace random rays through Geant4 and the converted VecGeom geometry.
+ *
+ * Geant4 rays use a \c G4Navigator on each thread. Worker threads use their
+ * own Geant4 geometry workspace so that replicated and parameterised volumes
+ * can be navigated concurrently. The VecGeom rays carry a navigation state
+ * from step to step and use the navigator configured for each volume in the
+ * closed VecGeom geometry.
+ *
+ * The origin and direction of each ray depend only on the seed and the ray
+ * index, so the result is independent of the number of threads.
+ */
+class NavigationValidator
+{
+  public:
+    //!@{
+    //! \name Type aliases
+    using result_type = Validation;
+    //!@}
+
+  public:
+    // Construct with converted geometry and options
+    NavigationValidator(Converted const& converted,
+                        Options const& options,
+                        ValidateOptions const& validate_options);
+
+    // Trace all rays
+    result_type operator()() const;
+
+  private:
+    //// TYPES ////
+
+    struct RayResult;
+    class G4Tracer;
+    class VgTracer;
+
+    //// DATA ////
+
+    Converted const& converted_;
+    double scale_;
+    ValidateOptions const& options_;
+    G4ThreeVector lower_;
+    G4ThreeVector upper_;
+
+    //// HELPER FUNCTIONS ////
+
+    // Trace a single ray
+    RayResult trace(std::size_t ray, G4Tracer&, VgTracer&) const;
+
+    // Trace a contiguous range of rays on the current thread
+    void
+    trace_range(std::size_t begin, std::size_t end, RayResult* results) const;
+};
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
@@ -0,0 +1,155 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/ParallelFor.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace g4vg
+{
+//---------------------------------------------------------------------------//
+// FREE FUNCTIONS
+//---------------------------------------------------------------------------//
+// Get the number of worker threads to use for a requested thread count
+inline unsigned int resolve_num_threads(unsigned int requested);
+
+// Call a function for every index in [0, count) on a pool of threads
+template<class F>
+void parallel_for(std::size_t count, unsigned int num_threads, F&& func);
+
+// Call a function in parallel with a scope object on each spawned thread
+template<class S, class F>
+void parallel_for_scoped(std::size_t count,
+                         unsigned int num_threads,
+                         F&& func);
+
+namespace detail
+{
+//! Thread scope that does nothing
+struct NoThreadScope
+{
+};
+}  // namespace detail
+
+//---------------------------------------------------------------------------//
+// INLINE DEFINITIONS
+//---------------------------------------------------------------------------//
+/*!
+ * Get the number of worker threads to use for a requested thread count.
+ *
+ * A value of zero requests one thread per hardware core.
+ */
+unsigned int resolve_num_threads(unsigned int requested)
+{
+    if (requested == 0)
+    {
+        requested = std::thread::hardware_concurrency();
+    }
+    return std::max(requested, 1u);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Call a function for every index in [0, count) on a pool of threads.
+ *
+ * Indices are claimed dynamically so that expensive items don't stall the
+ * other workers. The function must be safe to call concurrently for different
+ * indices. The first exception thrown by any worker is rethrown on the
+ * calling thread after all workers have finished.
+ */
+template<class F>
+void parallel_for(std::size_t count, unsigned int num_threads, F&& func)
+{
+    parallel_for_scoped<detail::NoThreadScope>(
+        count, num_threads, std::forward<F>(func));
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Call a function in parallel with a scope object on each spawned thread.
+ *
+ * An object of type \c S is default-constructed on each spawned worker
+ * thread before it claims any work, and destroyed after it finishes. This
+ * sets up and tears down per-thread state (such as a Geant4 workspace) that
+ * the calling thread already has. Exceptions from the scope are propagated
+ * like those from the function.
+ */
+template<class S, class F>
+void parallel_for_scoped(std::size_t count,
+                         unsigned int num_threads,
+                         F&& func)
+{
+    num_threads = static_cast<unsigned int>(
+        std::min<std::size_t>(resolve_num_threads(num_threads), count));
+
+    if (num_threads <= 1)
+    {
+        // Don't bother spawning a thread
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            func(i);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto work = [&](bool spawned) {
+        try
+        {
+            std::optional<S> scope;
+            if (spawned)
+            {
+                scope.emplace();
+            }
+            for (std::size_t i = next++; i < count; i = next++)
+            {
+                func(i);
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock{error_mutex};
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+            // Prevent other workers from claiming more work
+            next = count;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads - 1);
+    for (unsigned int t = 1; t != num_threads; ++t)
+    {
+        workers.emplace_back(work, /* spawned = */ true);
+    }
+    // Use the calling thread as a worker too
+    work(/* spawned = */ false);
+    for (auto& w : workers)
+    {
+        w.join();
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
@@ -0,0 +1,135 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/PlacementUpdater.cc
+//---------------------------------------------------------------------------//
+#include "PlacementUpdater.hh"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+#include <G4LogicalVolume.hh>
+#include <G4ReflectionFactory.hh>
+#include <G4VPhysicalVolume.hh>
+#include <VecGeom/management/GeoManager.h>
+#include <VecGeom/volumes/PlacedVolume.h>
+
+#include "AbsorbedDisplacement.hh"
+#include "Assert.hh"
+
+namespace g4vg
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Construct with converted geometry and the options used to convert it.
+ */
+PlacementUpdater::PlacementUpdater(Converted const& converted,
+                                   Options const& options)
+    : converted_{converted}
+    , reflection_factory_{options.reflection_factory}
+    , absorb_displaced_{options.absorb_displaced}
+    , convert_scale_{options.scale}
+    , convert_transform_{convert_scale_}
+{
+    G4VG_EXPECT(converted_.world);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Update the placements of the given volumes.
+ *
+ * Each volume must be a normal (not replicated or parameterised) placement
+ * that was converted exactly once. A volume whose logical volume is reflected
+ * by the Geant4 reflection factory cannot be updated, since its VecGeom
+ * placement also includes the reflection. The root of the converted geometry
+ * is always placed at the origin and is ignored.
+ *
+ * All volumes are checked and their new transforms are built before any
+ * placement is modified, so if an error is raised the VecGeom geometry is
+ * unchanged.
+ */
+void PlacementUpdater::operator()(VecPv const& changed) const
+{
+    auto& geo_manager = vecgeom::GeoManager::Instance();
+    auto const& index = converted_.pv_index;
+    auto pv_less = [](Converted::PvIndexEntry const& a,
+                      Converted::PvIndexEntry const& b) {
+        return std::less<G4VPhysicalVolume const*>{}(a.pv, b.pv);
+    };
+
+    // Validate all changes and build their transforms before moving any
+    std::vector<std::pair<vecgeom::VPlacedVolume*, Transformer::result_type>>
+        updates;
+    updates.reserve(changed.size());
+    for (G4VPhysicalVolume const* g4pv : changed)
+    {
+        G4VG_EXPECT(g4pv);
+        G4VG_VALIDATE(g4pv->VolumeType() == EVolume::kNormal,
+                      << "cannot update the placement of replicated or "
+                         "parameterised volume '"
+                      << g4pv->GetName() << "'");
+        if (reflection_factory_)
+        {
+            auto* lv = g4pv->GetLogicalVolume();
+            G4VG_VALIDATE(
+                !G4ReflectionFactory::Instance()->GetConstituentLV(lv),
+                << "cannot update the placement of reflected volume '"
+                << g4pv->GetName() << "'");
+        }
+
+        Converted::PvIndexEntry const key{g4pv, 0, 0};
+        auto [first, last]
+            = std::equal_range(index.begin(), index.end(), key, pv_less);
+        G4VG_VALIDATE(first != last,
+                      << "physical volume '" << g4pv->GetName()
+                      << "' was not converted");
+        G4VG_VALIDATE(last - first == 1,
+                      << "physical volume '" << g4pv->GetName()
+                      << "' was placed more than once (inside a reflected "
+                         "volume)");
+        if (first->id == converted_.world->id())
+        {
+            // The root is always at the origin
+            continue;
+        }
+
+        auto* vgpv = geo_manager.FindPlacedVolume(first->id);
+        G4VG_ASSERT(vgpv);
+        auto trans
+            = convert_transform_(g4pv->GetTranslation(), g4pv->GetRotation());
+        if (absorb_displaced_)
+        {
+            if (auto absorbed = find_absorbed_displacement(
+                    *g4pv->GetLogicalVolume(), reflection_factory_))
+            {
+                // Reapply the displacement of the solid
+                trans = convert_transform_(
+                    absorbed.transform
+                    * G4AffineTransform(g4pv->GetRotation(),
+                                        g4pv->GetTranslation()));
+            }
+        }
+#ifndef VECGEOM_NO_SPECIALIZATION
+        // Specialized placed volumes assume the type of transform is fixed
+        auto const* old_trans = vgpv->GetTransformation();
+        G4VG_VALIDATE(
+            trans.GenerateTranslationCode()
+                    == old_trans->GenerateTranslationCode()
+                && trans.GenerateRotationCode()
+                       == old_trans->GenerateRotationCode(),
+            << "updated placement of '" << g4pv->GetName()
+            << "' changes the specialization of its transform");
+#endif
+        updates.emplace_back(vgpv, trans);
+    }
+
+    for (auto const& [vgpv, trans] : updates)
+    {
+        vgpv->SetTransformation(&trans);
+    }
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
@@ -0,0 +1,47 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/PlacementUpdater.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include "G4VG.hh"
+#include "Scaler.hh"
+#include "Transformer.hh"
+
+namespace g4vg
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Move VecGeom placed volumes to match their modified Geant4 placements.
+ *
+ * Only the transforms of existing placements are changed, so volume IDs and
+ * the rest of the converted geometry are unaffected. Changes to solids,
+ * materials, or the volume hierarchy require a new conversion.
+ */
+class PlacementUpdater
+{
+  public:
+    //!@{
+    //! \name Type aliases
+    using VecPv = Converted::VecPv;
+    //!@}
+
+  public:
+    // Construct with converted geometry and the options used to convert it
+    PlacementUpdater(Converted const& converted, Options const& options);
+
+    // Update the placements of the given volumes
+    void operator()(VecPv const& changed) const;
+
+  private:
+    Converted const& converted_;
+    bool reflection_factory_;
+    bool absorb_displaced_;
+    Scaler convert_scale_;
+    Transformer convert_transform_;
+};
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
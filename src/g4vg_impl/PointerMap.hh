@@ -0,0 +1,383 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/PointerMap.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Assert.hh"
+
+namespace g4vg
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+//! Slot layout of a pointer-keyed map
+template<class K, class V>
+struct PointerMapTraits
+{
+    using value_type = std::pair<K, V>;
+    static K key(value_type const& v) { return v.first; }
+};
+
+//! Slot layout of a pointer set
+template<class K>
+struct PointerSetTraits
+{
+    using value_type = K;
+    static K key(value_type const& v) { return v; }
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Forward iterator over the occupied slots of a flat table.
+ *
+ * A slot is empty if its key is null.
+ */
+template<class Traits, class T>
+class SlotIterator
+{
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::remove_const_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    SlotIterator() = default;
+    SlotIterator(T* pos, T* end) : pos_(pos), end_(end) { this->skip_empty(); }
+
+    //! Allow conversion from mutable to const iterator
+    template<class U,
+             class = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+    SlotIterator(SlotIterator<Traits, U> const& other)
+        : pos_(other.pos_), end_(other.end_)
+    {
+    }
+
+    reference operator*() const { return *pos_; }
+    pointer operator->() const { return pos_; }
+
+    SlotIterator& operator++()
+    {
+        ++pos_;
+        this->skip_empty();
+        return *this;
+    }
+    SlotIterator operator++(int)
+    {
+        SlotIterator result{*this};
+        ++*this;
+        return result;
+    }
+
+    bool operator==(SlotIterator const& other) const
+    {
+        return pos_ == other.pos_;
+    }
+    bool operator!=(SlotIterator const& other) const
+    {
+        return pos_ != other.pos_;
+    }
+
+  private:
+    template<class, class>
+    friend class SlotIterator;
+
+    T* pos_{nullptr};
+    T* end_{nullptr};
+
+    void skip_empty()
+    {
+        while (pos_ != end_ && !Traits::key(*pos_))
+        {
+            ++pos_;
+        }
+    }
+};
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+
+//---------------------------------------------------------------------------//
+/*!
+ * Flat open-addressing hash table keyed on non-null pointers.
+ *
+ * All entries are stored contiguously in a power-of-two array of slots, with
+ * a null key marking an empty slot. Lookups use Fibonacci hashing of the
+ * pointer value followed by linear probing, and the table is kept at most
+ * half full so that probe sequences stay short. Unlike the node-based
+ * standard containers, inserting does not allocate (except when growing) and
+ * a lookup touches only one or two cache lines.
+ *
+ * Entries can't be erased. Inserting may rehash the table, which invalidates
+ * all iterators and references. Iteration order is unspecified.
+ */
+template<class Traits>
+class PointerTable
+{
+  public:
+    //!@{
+    //! \name Type aliases
+    using value_type = typename Traits::value_type;
+    using key_type = std::remove_cv_t<std::remove_reference_t<decltype(
+        Traits::key(std::declval<value_type const&>()))>>;
+    using size_type = std::size_t;
+    //!@}
+
+    static_assert(std::is_pointer<key_type>::value, "keys must be pointers");
+
+    using iterator = detail::SlotIterator<Traits, value_type>;
+    using const_iterator = detail::SlotIterator<Traits, value_type const>;
+
+  public:
+    //// CONSTRUCTION ////
+
+    PointerTable() = default;
+
+    //// ACCESSORS ////
+
+    //! Number of entries
+    size_type size() const { return size_; }
+
+    //! Whether no entries are present
+    bool empty() const { return size_ == 0; }
+
+    //! Number of allocated slots
+    size_type bucket_count() const { return slots_.size(); }
+
+    //! Size of a single slot in bytes
+    static constexpr size_type slot_size() { return sizeof(value_type); }
+
+    // Find an entry
+    inline iterator find(key_type key);
+    inline const_iterator find(key_type key) const;
+
+    //! Whether the key is present (zero or one)
+    size_type count(key_type key) const
+    {
+        return this->find(key) != this->end() ? 1 : 0;
+    }
+
+    //!@{
+    //! Iterate over entries
+    iterator begin() { return this->make_iter(0); }
+    iterator end() { return this->make_iter(slots_.size()); }
+    const_iterator begin() const { return this->make_iter(0); }
+    const_iterator end() const { return this->make_iter(slots_.size()); }
+    //!@}
+
+    //// MUTATORS ////
+
+    // Insert an entry if its key is not present
+    inline std::pair<iterator, bool> insert(value_type value);
+
+    // Allocate enough slots for the given number of entries
+    inline void reserve(size_type count);
+
+  private:
+    //// CONSTANTS ////
+
+    static constexpr size_type min_capacity() { return 16; }
+
+    //// DATA ////
+
+    std::vector<value_type> slots_;
+    size_type size_{0};
+    unsigned int shift_{64};
+
+    //// HELPER FUNCTIONS ////
+
+    // Index of the slot holding the key, or the empty slot that would
+    inline size_type find_slot(key_type key) const;
+
+    // Move all entries into a new array of slots
+    inline void rehash(size_type capacity);
+
+    iterator make_iter(size_type i)
+    {
+        auto* data = slots_.data();
+        return {data + i, data + slots_.size()};
+    }
+    const_iterator make_iter(size_type i) const
+    {
+        auto const* data = slots_.data();
+        return {data + i, data + slots_.size()};
+    }
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Flat hash map keyed on non-null pointers.
+ */
+template<class K, class V>
+class PointerMap : public PointerTable<detail::PointerMapTraits<K, V>>
+{
+    using Base = PointerTable<detail::PointerMapTraits<K, V>>;
+
+  public:
+    using mapped_type = V;
+
+    //! Access the value for a key, inserting a default if not present
+    mapped_type& operator[](K key)
+    {
+        return this->insert({key, mapped_type{}}).first->second;
+    }
+};
+
+//---------------------------------------------------------------------------//
+//! Flat hash set of non-null pointers
+template<class K>
+using PointerSet = PointerTable<detail::PointerSetTraits<K>>;
+
+//---------------------------------------------------------------------------//
+// INLINE DEFINITIONS
+//---------------------------------------------------------------------------//
+/*!
+ * Find an entry.
+ */
+template<class Traits>
+auto PointerTable<Traits>::find(key_type key) -> iterator
+{
+    if (slots_.empty())
+    {
+        return this->end();
+    }
+    size_type i = this->find_slot(key);
+    return Traits::key(slots_[i]) ? this->make_iter(i) : this->end();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Find an entry.
+ */
+template<class Traits>
+auto PointerTable<Traits>::find(key_type key) const -> const_iterator
+{
+    if (slots_.empty())
+    {
+        return this->end();
+    }
+    size_type i = this->find_slot(key);
+    return Traits::key(slots_[i]) ? this->make_iter(i) : this->end();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Insert an entry if its key is not present.
+ *
+ * The result is the iterator to the entry with the key and whether the entry
+ * was inserted, as with \c std::unordered_map::insert .
+ */
+template<class Traits>
+auto PointerTable<Traits>::insert(value_type value)
+    -> std::pair<iterator, bool>
+{
+    key_type key = Traits::key(value);
+    G4VG_EXPECT(key);
+
+    if (2 * (size_ + 1) > slots_.size())
+    {
+        if (!slots_.empty())
+        {
+            // Don't grow the table if the key is already present
+            size_type i = this->find_slot(key);
+            if (Traits::key(slots_[i]))
+            {
+                return {this->make_iter(i), false};
+            }
+        }
+        this->rehash(std::max(min_capacity(), 2 * slots_.size()));
+    }
+
+    size_type i = this->find_slot(key);
+    if (Traits::key(slots_[i]))
+    {
+        return {this->make_iter(i), false};
+    }
+    slots_[i] = std::move(value);
+    ++size_;
+    return {this->make_iter(i), true};
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Allocate enough slots for the given number of entries.
+ */
+template<class Traits>
+void PointerTable<Traits>::reserve(size_type count)
+{
+    size_type capacity = min_capacity();
+    while (capacity < 2 * count)
+    {
+        capacity *= 2;
+    }
+    if (capacity > slots_.size())
+    {
+        this->rehash(capacity);
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Index of the slot holding the key, or the empty slot that would.
+ *
+ * The multiplier is 2^64 divided by the golden ratio, which spreads the
+ * aligned (and thus low-bit-poor) pointer values across the high bits.
+ */
+template<class Traits>
+auto PointerTable<Traits>::find_slot(key_type key) const -> size_type
+{
+    G4VG_EXPECT(!slots_.empty());
+    auto hash = static_cast<std::uint64_t>(
+                    reinterpret_cast<std::uintptr_t>(key))
+                * UINT64_C(11400714819323198485);
+    size_type const mask = slots_.size() - 1;
+    for (auto i = static_cast<size_type>(hash >> shift_);;
+         i = (i + 1) & mask)
+    {
+        key_type k = Traits::key(slots_[i]);
+        if (k == key || !k)
+        {
+            return i;
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Move all entries into a new array of slots.
+ */
+template<class Traits>
+void PointerTable<Traits>::rehash(size_type capacity)
+{
+    G4VG_EXPECT(capacity >= min_capacity() && !(capacity & (capacity - 1)));
+
+    std::vector<value_type> old(capacity, value_type{});
+    std::swap(old, slots_);
+    shift_ = 64;
+    for (size_type c = capacity; c > 1; c /= 2)
+    {
+        --shift_;
+    }
+
+    for (auto& v : old)
+    {
+        if (Traits::key(v))
+        {
+            slots_[this->find_slot(Traits::key(v))] = std::move(v);
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
@@ -6,11 +6,14 @@
 //---------------------------------------------------------------------------//
 #include "SolidConverter.hh"
 
+#include <algorithm>
 #include <string_view>
 #include <typeindex>
 #include <typeinfo>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
+#include <G4AffineTransform.hh>
 #include <G4BooleanSolid.hh>
 #include <G4Box.hh>
 #include <G4Cons.hh>
@@ -22,6 +25,7 @@
 #include <G4ExtrudedSolid.hh>
 #include <G4GenericPolycone.hh>
 #include <G4GenericTrap.hh>
+#include <G4GeometryTolerance.hh>
 #include <G4Hype.hh>
 #include <G4IntersectionSolid.hh>
 #include <G4LogicalVolume.hh>
@@ -64,6 +68,7 @@
 #include <VecGeom/volumes/UnplacedGenTrap.h>
 #include <VecGeom/volumes/UnplacedGenericPolycone.h>
 #include <VecGeom/volumes/UnplacedHype.h>
+#include <VecGeom/volumes/UnplacedMultiUnion.h>
 #include <VecGeom/volumes/UnplacedOrb.h>
 #include <VecGeom/volumes/UnplacedParaboloid.h>
 #include <VecGeom/volumes/UnplacedParallelepiped.h>
@@ -79,8 +84,13 @@
 #include <VecGeom/volumes/UnplacedTrd.h>
 #include <VecGeom/volumes/UnplacedTube.h>
 
+#include "HashCombine.hh"
 #include "Logger.hh"
+#include "ParallelFor.hh"
 #include "Scaler.hh"
+#include "SolidParameters.hh"
+#include "Stopwatch.hh"
+#include "TraceWriter.hh"
 #include "Transformer.hh"
 #include "TypeDemangler.hh"
 
@@ -126,6 +136,219 @@ make_unplaced_boolean(VPlacedVolume const* left, VPlacedVolume const* right)
     return GeoManager::MakeInstance<UnplacedBooleanVolume<Op>>(Op, left, right);
 }
 
+//---------------------------------------------------------------------------//
+//! Exact position of a tessellated solid vertex
+using VertexKey = std::array<double, 3>;
+
+//! Hash a vertex position
+struct VertexKeyHash
+{
+    std::size_t operator()(VertexKey const& v) const
+    {
+        std::size_t result = 0;
+        for (double x : v)
+        {
+            hash_combine(result, x);
+        }
+        return result;
+    }
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Remove repeated vertices from a facet's vertex indices.
+ *
+ * A repeated adjacent vertex (e.g., a quadrilateral collapsed to a triangle)
+ * is removed. The return value is the number of remaining vertices, or zero
+ * if fewer than three distinct vertices remain.
+ */
+int remove_repeated_vertices(std::array<int, 4>& indices, int num_vtx)
+{
+    std::array<int, 4> result{{-1, -1, -1, -1}};
+    int count = 0;
+    for (int i = 0; i < num_vtx; ++i)
+    {
+        if (count == 0 || indices[i] != result[count - 1])
+        {
+            result[count++] = indices[i];
+        }
+    }
+    if (count > 1 && result[count - 1] == result[0])
+    {
+        --count;
+    }
+    for (int i = 0; i < count; ++i)
+    {
+        for (int j = i + 1; j < count; ++j)
+        {
+            if (result[i] == result[j])
+            {
+                // Facet folds back on itself
+                return 0;
+            }
+        }
+    }
+    indices = result;
+    return count < 3 ? 0 : count;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Whether a welded facet has a nonzero area.
+ *
+ * Twice the facet's vector area is compared with its longest edge: a facet
+ * whose width perpendicular to that edge is within the tolerance (e.g., one
+ * with collinear vertices) has no area.
+ */
+bool has_area(std::vector<G4ThreeVector> const& vertices,
+              std::array<int, 4> const& indices,
+              int num_vtx,
+              double tolerance)
+{
+    G4ThreeVector const& origin = vertices[indices[0]];
+    G4ThreeVector area(0, 0, 0);
+    double max_edge = 0;
+    for (int i = 0; i < num_vtx; ++i)
+    {
+        G4ThreeVector const& v = vertices[indices[i]];
+        G4ThreeVector const& next = vertices[indices[(i + 1) % num_vtx]];
+        area += (v - origin).cross(next - origin);
+        max_edge = std::max(max_edge, (next - v).mag());
+    }
+    return area.mag() > tolerance * max_edge;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Mirror the z planes of a polycone or polyhedron.
+ *
+ * The planes are reversed so that z is still nondecreasing.
+ */
+void reflect_z_planes(std::vector<double>& z,
+                      std::vector<double>& rmin,
+                      std::vector<double>& rmax)
+{
+    std::reverse(z.begin(), z.end());
+    std::reverse(rmin.begin(), rmin.end());
+    std::reverse(rmax.begin(), rmax.end());
+    for (double& zval : z)
+    {
+        zval = -zval;
+    }
+}
+
+//---------------------------------------------------------------------------//
+//! Constituent of a union and its transform relative to the union
+using TransformedSolid = std::pair<G4VSolid const*, G4AffineTransform>;
+
+//---------------------------------------------------------------------------//
+/*!
+ * Find the non-union components of a tree of unions.
+ *
+ * Displaced constituents are expanded so that each component's transform is
+ * relative to the root of the tree.
+ */
+void flatten_union(G4VSolid const& solid,
+                   G4AffineTransform const& parent,
+                   std::vector<TransformedSolid>* result)
+{
+    if (auto* displaced = dynamic_cast<G4DisplacedSolid const*>(&solid))
+    {
+        // Apply the displacement and then the parent's transform
+        G4VSolid const* moved = displaced->GetConstituentMovedSolid();
+        G4VG_ASSERT(moved);
+        flatten_union(
+            *moved, displaced->GetTransform().Invert() * parent, result);
+    }
+    else if (auto* bs = dynamic_cast<G4UnionSolid const*>(&solid))
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            G4VSolid const* constituent = bs->GetConstituentSolid(i);
+            G4VG_ASSERT(constituent);
+            flatten_union(*constituent, parent, result);
+        }
+    }
+    else
+    {
+        result->push_back({&solid, parent});
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Depth of a tree of unions.
+ *
+ * A non-union solid has depth zero.
+ */
+int union_depth(G4VSolid const& solid)
+{
+    if (auto* displaced = dynamic_cast<G4DisplacedSolid const*>(&solid))
+    {
+        return union_depth(*displaced->GetConstituentMovedSolid());
+    }
+    if (auto* bs = dynamic_cast<G4UnionSolid const*>(&solid))
+    {
+        return 1
+               + std::max(union_depth(*bs->GetConstituentSolid(0)),
+                          union_depth(*bs->GetConstituentSolid(1)));
+    }
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
+//! Axis-aligned bounding box of a boolean constituent
+struct BoundingBox
+{
+    G4ThreeVector lower;
+    G4ThreeVector upper;
+};
+
+//! Get the bounding box of a solid (including any displacement)
+BoundingBox bounding_box(G4VSolid const& solid)
+{
+    BoundingBox result;
+    solid.BoundingLimits(result.lower, result.upper);
+    return result;
+}
+
+//! Whether two boxes have no points in common
+bool is_disjoint(BoundingBox const& a, BoundingBox const& b)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        if (a.upper[i] < b.lower[i] || b.upper[i] < a.lower[i])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//! Whether the inner box is entirely inside the outer box
+bool encloses(BoundingBox const& outer, BoundingBox const& inner)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        if (inner.lower[i] < outer.lower[i] || inner.upper[i] > outer.upper[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! Whether a solid exactly fills its bounding box
+bool is_aligned_box(G4VSolid const& solid)
+{
+    if (auto* displaced = dynamic_cast<G4DisplacedSolid const*>(&solid))
+    {
+        return !displaced->GetTransform().IsRotated()
+               && is_aligned_box(*displaced->GetConstituentMovedSolid());
+    }
+    return typeid(solid) == typeid(G4Box);
+}
+
 //---------------------------------------------------------------------------//
 /*!
  * Create a temporary volume name.
@@ -151,15 +374,18 @@ std::string make_temp_name(std::string_view name, std::string_view suffix)
  */
 auto SolidConverter::operator()(arg_type solid_base) -> result_type
 {
-    auto [cache_iter, inserted] = cache_.insert({&solid_base, nullptr});
-    if (inserted)
+    if (auto iter = cache_.find(&solid_base); iter != cache_.end())
     {
-        // First time converting the solid
-        cache_iter->second = this->convert_impl(solid_base);
+        return iter->second;
     }
 
-    G4VG_ENSURE(cache_iter->second);
-    return cache_iter->second;
+    // First time converting the solid: the cache may be rehashed while
+    // converting constituents, so insert only after
+    result_type result = deduplicate_ ? this->convert_unique(solid_base)
+                                      : this->convert_impl(solid_base);
+    G4VG_ENSURE(result);
+    cache_.insert({&solid_base, result});
+    return result;
 }
 
 //---------------------------------------------------------------------------//
@@ -173,13 +399,233 @@ auto SolidConverter::to_sphere(arg_type solid_base) const -> result_type
     return GeoManager::MakeInstance<UnplacedOrb>(radius);
 }
 
+//---------------------------------------------------------------------------//
+/*!
+ * Convert the primitive solids used by the given solids in parallel.
+ *
+ * Boolean, displaced, and reflected solids create temporary VecGeom logical
+ * and placed volumes whose IDs depend on the conversion order, so only their
+ * underlying primitives (which are independent of the global VecGeom state)
+ * are converted here. The results are added to the cache in the order the
+ * solids are first encountered, and anything that fails to convert is left
+ * for the serial pass to report.
+ */
+void SolidConverter::preconvert(VecSolid const& solids,
+                                unsigned int num_threads)
+{
+    // Find unconverted primitives, expanding composite solids depth-first
+    VecSolid primitives;
+    PointerSet<G4VSolid const*> visited;
+    visited.reserve(solids.size());
+    VecSolid stack(solids.rbegin(), solids.rend());
+    while (!stack.empty())
+    {
+        G4VSolid const* solid = stack.back();
+        stack.pop_back();
+        G4VG_ASSERT(solid);
+        if (!visited.insert(solid).second || cache_.count(solid))
+        {
+            continue;
+        }
+
+        if (auto* bs = dynamic_cast<G4BooleanSolid const*>(solid))
+        {
+            stack.push_back(bs->GetConstituentSolid(1));
+            stack.push_back(bs->GetConstituentSolid(0));
+        }
+        else if (auto* ds = dynamic_cast<G4DisplacedSolid const*>(solid))
+        {
+            stack.push_back(ds->GetConstituentMovedSolid());
+        }
+        else if (auto* rs = dynamic_cast<G4ReflectedSolid const*>(solid))
+        {
+            stack.push_back(rs->GetConstituentMovedSolid());
+        }
+        else if (find_converter(*solid))
+        {
+            primitives.push_back(solid);
+        }
+    }
+
+    std::vector<SolidKey> keys;
+    if (deduplicate_)
+    {
+        // Convert only the first of each group of identical solids: the
+        // others are deduplicated when the serial pass reaches them
+        std::unordered_set<SolidKey, SolidKeyHash> seen;
+        auto keep = primitives.begin();
+        for (G4VSolid const* solid : primitives)
+        {
+            SolidKey key = this->make_key(*solid);
+            if (key.params.empty()
+                || (!unique_.count(key) && seen.insert(key).second))
+            {
+                keys.push_back(std::move(key));
+                *keep++ = solid;
+            }
+        }
+        primitives.erase(keep, primitives.end());
+    }
+
+    G4VG_LOG(debug) << "Converting " << primitives.size()
+                    << " primitive solids using "
+                    << std::min<std::size_t>(resolve_num_threads(num_threads),
+                                             primitives.size())
+                    << " threads";
+
+    std::vector<result_type> converted(primitives.size(), nullptr);
+    std::vector<double> times(primitives.size(), 0.0);
+    parallel_for(primitives.size(), num_threads, [&](std::size_t i) {
+        try
+        {
+            TraceSpan span(trace_, primitives[i]->GetName(), "solid");
+            if (span)
+            {
+                span.arg("type", TypeDemangler<G4VSolid>{}(*primitives[i]));
+            }
+            Stopwatch get_time;
+            ConvertFuncPtr fp = find_converter(*primitives[i]);
+            converted[i] = (this->*fp)(*primitives[i]);
+            times[i] = get_time();
+        }
+        catch (g4vg::RuntimeError const&)
+        {
+            // Leave it for the serial pass to retry and report
+        }
+    });
+
+    for (std::size_t i = 0; i != primitives.size(); ++i)
+    {
+        if (!converted[i])
+        {
+            continue;
+        }
+        if (G4VG_UNLIKELY(statistics_))
+        {
+            this->record_time(*primitives[i], times[i]);
+        }
+        if (G4VG_UNLIKELY(compare_volumes_))
+        {
+            this->compare_volumes(*primitives[i], *converted[i]);
+        }
+        cache_.insert({primitives[i], converted[i]});
+        if (deduplicate_ && !keys[i].params.empty())
+        {
+            unique_.insert({std::move(keys[i]), converted[i]});
+        }
+    }
+}
+
 //---------------------------------------------------------------------------//
 /*!
  * Convert a solid that's not in the cache.
  */
 auto SolidConverter::convert_impl(arg_type solid_base) -> result_type
 {
-    using ConvertFuncPtr = result_type (SolidConverter::*)(arg_type);
+    ConvertFuncPtr fp = find_converter(solid_base);
+    G4VG_VALIDATE(fp,
+                  << "unsupported solid type "
+                  << TypeDemangler<G4VSolid>{}(solid_base));
+
+    TraceSpan span(trace_, solid_base.GetName(), "solid");
+    if (span)
+    {
+        span.arg("type", TypeDemangler<G4VSolid>{}(solid_base));
+    }
+
+    // Call our corresponding member function to convert the solid
+    Stopwatch get_time;
+    result_type result = (this->*fp)(solid_base);
+    if (G4VG_UNLIKELY(statistics_))
+    {
+        this->record_time(solid_base, get_time());
+    }
+    if (G4VG_UNLIKELY(compare_volumes_))
+    {
+        G4VG_ASSERT(result);
+        this->compare_volumes(solid_base, *result);
+    }
+
+    G4VG_ENSURE(result);
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Convert a solid or reuse a structurally identical one.
+ */
+auto SolidConverter::convert_unique(arg_type solid_base) -> result_type
+{
+    SolidKey key = this->make_key(solid_base);
+    if (key.params.empty())
+    {
+        // Unsupported type for deduplication
+        return this->convert_impl(solid_base);
+    }
+
+    if (auto iter = unique_.find(key); iter != unique_.end())
+    {
+        ++num_deduplicated_;
+        return iter->second;
+    }
+
+    // Convert before inserting: conversion may recurse and rehash the map
+    result_type result = this->convert_impl(solid_base);
+    unique_.emplace(std::move(key), result);
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Construct a deduplication key.
+ *
+ * The key contains every scaled parameter that the corresponding converter
+ * passes to VecGeom, so solids with equal keys are converted to identical
+ * unplaced volumes. Only common primitive solids are supported; other types
+ * return a key with empty parameters.
+ */
+auto SolidConverter::make_key(arg_type solid_base) const -> SolidKey
+{
+    return {std::type_index(typeid(solid_base)),
+            solid_parameters(solid_base, scale_)};
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Hash a deduplication key.
+ */
+std::size_t SolidConverter::SolidKeyHash::operator()(SolidKey const& key) const
+{
+    std::size_t result = std::hash<std::type_index>{}(key.type);
+    for (double v : key.params)
+    {
+        hash_combine(result, v);
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Hash a temporary placement key.
+ */
+std::size_t SolidConverter::TempKeyHash::operator()(TempKey const& key) const
+{
+    std::size_t result = std::hash<VUnplacedVolume const*>{}(key.unplaced);
+    for (double v : key.trans)
+    {
+        hash_combine(result, v);
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Find the member function that converts a solid type.
+ *
+ * This returns null if the solid type is unsupported.
+ */
+auto SolidConverter::find_converter(arg_type solid_base) -> ConvertFuncPtr
+{
     using MapTypeConverter
         = std::unordered_map<std::type_index, ConvertFuncPtr>;
 
@@ -221,23 +667,62 @@ auto SolidConverter::convert_impl(arg_type solid_base) -> result_type
     // Look up converter function based on the solid's C++ type
     auto func_iter
         = type_to_converter.find(std::type_index(typeid(solid_base)));
+    if (func_iter == type_to_converter.end())
+    {
+        return nullptr;
+    }
+    return func_iter->second;
+}
 
-    result_type result = nullptr;
-    G4VG_VALIDATE(func_iter != type_to_converter.end(),
-                  << "unsupported solid type "
-                  << TypeDemangler<G4VSolid>{}(solid_base));
+//---------------------------------------------------------------------------//
+/*!
+ * Find the member function that converts the mirror image of a solid in z.
+ *
+ * This returns null if the mirror image can't be constructed as a primitive.
+ */
+auto SolidConverter::find_reflector(arg_type solid_base) -> ConvertFuncPtr
+{
+    using MapTypeConverter
+        = std::unordered_map<std::type_index, ConvertFuncPtr>;
 
-    // Call our corresponding member function to convert the solid
-    ConvertFuncPtr fp = func_iter->second;
-    result = (this->*fp)(solid_base);
-    if (G4VG_UNLIKELY(compare_volumes_))
+    // clang-format off
+    #define VGSC_TYPE_FUNC(MIXED, LOWER) \
+    {std::type_index(typeid(G4##MIXED)), &SolidConverter::LOWER}
+    static const MapTypeConverter type_to_reflector = {
+        VGSC_TYPE_FUNC(Box              , symmetric_z),
+        VGSC_TYPE_FUNC(Cons             , reflected_cons),
+        VGSC_TYPE_FUNC(CutTubs          , reflected_cuttubs),
+        VGSC_TYPE_FUNC(EllipticalTube   , symmetric_z),
+        VGSC_TYPE_FUNC(Hype             , symmetric_z),
+        VGSC_TYPE_FUNC(Orb              , symmetric_z),
+        VGSC_TYPE_FUNC(Polycone         , reflected_polycone),
+        VGSC_TYPE_FUNC(Polyhedra        , reflected_polyhedra),
+        VGSC_TYPE_FUNC(Sphere           , reflected_sphere),
+        VGSC_TYPE_FUNC(Torus            , symmetric_z),
+        VGSC_TYPE_FUNC(Trd              , reflected_trd),
+        VGSC_TYPE_FUNC(Tubs             , symmetric_z),
+    };
+    // clang-format on
+#undef VGSC_TYPE_FUNC
+
+    auto func_iter
+        = type_to_reflector.find(std::type_index(typeid(solid_base)));
+    if (func_iter == type_to_reflector.end())
     {
-        G4VG_ASSERT(result);
-        this->compare_volumes(solid_base, *result);
+        return nullptr;
     }
+    return func_iter->second;
+}
 
-    G4VG_ENSURE(result);
-    return result;
+//---------------------------------------------------------------------------//
+/*!
+ * Add the time to convert a solid to the statistics.
+ */
+void SolidConverter::record_time(arg_type solid_base, double seconds)
+{
+    auto& type_stats = type_stats_[solid_base.GetEntityType()];
+    ++type_stats.count;
+    type_stats.time += seconds;
 }
 
 //---------------------------------------------------------------------------//
@@ -299,15 +784,17 @@ auto SolidConverter::displacedsolid(arg_type solid_base) -> result_type
 
     // Create temporary PV from converted solid
     Transformation3D trans = transform_(solid.GetTransform().Invert());
-    auto* orig_lv = new LogicalVolume(
-        make_temp_name(solid.GetName(), "base").c_str(), orig_solid);
-    auto* orig_pv = orig_lv->Place(&trans);
+    auto* orig_pv = this->make_temp_pv(
+        make_temp_name(solid.GetName(), "base"), orig_solid, trans);
 
     // Create empty box
-    auto* box_solid = GeoManager::MakeInstance<UnplacedBox>(0, 0, 0);
-    auto* box_lv = new LogicalVolume(
-        make_temp_name(solid.GetName(), "box").c_str(), box_solid);
-    auto* box_pv = box_lv->Place(&Transformation3D::kIdentity);
+    if (!empty_box_)
+    {
+        empty_box_ = GeoManager::MakeInstance<UnplacedBox>(0, 0, 0);
+    }
+    auto* box_pv = this->make_temp_pv(make_temp_name(solid.GetName(), "box"),
+                                      empty_box_,
+                                      Transformation3D::kIdentity);
 
     return make_unplaced_boolean<kUnion>(orig_pv, box_pv);
 }
@@ -444,8 +931,25 @@ auto SolidConverter::hype(arg_type solid_base) -> result_type
 //! Convert an intersection solid
 auto SolidConverter::intersectionsolid(arg_type solid_base) -> result_type
 {
-    PlacedBoolVolumes pv = this->convert_bool_impl(
-        dynamic_cast<G4BooleanSolid const&>(solid_base));
+    auto const& solid = dynamic_cast<G4BooleanSolid const&>(solid_base);
+
+    if (simplify_booleans_)
+    {
+        // Intersecting with a box that encloses the other operand is a no-op
+        for (int i = 0; i < 2; ++i)
+        {
+            G4VSolid const& box = *solid.GetConstituentSolid(i);
+            G4VSolid const& other = *solid.GetConstituentSolid(1 - i);
+            if (is_aligned_box(box)
+                && encloses(bounding_box(box), bounding_box(other)))
+            {
+                ++num_pruned_booleans_;
+                return (*this)(other);
+            }
+        }
+    }
+
+    PlacedBoolVolumes pv = this->convert_bool_impl(solid);
     return make_unplaced_boolean<kIntersection>(pv[0], pv[1]);
 }
 
@@ -494,7 +998,15 @@ auto SolidConverter::paraboloid(arg_type solid_base) -> result_type
 //! Convert a polycone
 auto SolidConverter::polycone(arg_type solid_base) -> result_type
 {
-    auto const& solid = dynamic_cast<G4Polycone const&>(solid_base);
+    return this->polycone_impl(dynamic_cast<G4Polycone const&>(solid_base),
+                               /* reflect_z = */ false);
+}
+
+//---------------------------------------------------------------------------//
+//! Convert a polycone, optionally mirrored in z
+auto SolidConverter::polycone_impl(G4Polycone const& solid, bool reflect_z)
+    -> result_type
+{
     auto const& params = *solid.GetOriginalParameters();
 
     std::vector<double> zvals(params.Num_z_planes);
@@ -506,6 +1018,10 @@ auto SolidConverter::polycone(arg_type solid_base) -> result_type
         rmins[i] = scale_(params.Rmin[i]);
         rmaxs[i] = scale_(params.Rmax[i]);
     }
+    if (reflect_z)
+    {
+        reflect_z_planes(zvals, rmins, rmaxs);
+    }
     return GeoManager::MakeInstance<UnplacedPolycone>(params.Start_angle,
                                                       params.Opening_angle,
                                                       zvals.size(),
@@ -518,7 +1034,15 @@ auto SolidConverter::polycone(arg_type solid_base) -> result_type
 //! Convert a polyhedron
 auto SolidConverter::polyhedra(arg_type solid_base) -> result_type
 {
-    auto const& solid = dynamic_cast<G4Polyhedra const&>(solid_base);
+    return this->polyhedra_impl(dynamic_cast<G4Polyhedra const&>(solid_base),
+                                /* reflect_z = */ false);
+}
+
+//---------------------------------------------------------------------------//
+//! Convert a polyhedron, optionally mirrored in z
+auto SolidConverter::polyhedra_impl(G4Polyhedra const& solid, bool reflect_z)
+    -> result_type
+{
     auto const& params = *solid.GetOriginalParameters();
     // G4 has a different radius conventions (than TGeo, gdml, VecGeom)!
     double const radius_factor
@@ -533,6 +1057,10 @@ auto SolidConverter::polyhedra(arg_type solid_base) -> result_type
         rmins[i] = scale_(params.Rmin[i] * radius_factor);
         rmaxs[i] = scale_(params.Rmax[i] * radius_factor);
     }
+    if (reflect_z)
+    {
+        reflect_z_planes(zs, rmins, rmaxs);
+    }
 
     auto phistart = std::fmod(params.Start_angle, 2 * constants::pi);
 
@@ -553,16 +1081,24 @@ auto SolidConverter::reflectedsolid(arg_type solid_base) -> result_type
     G4VSolid* underlying = solid.GetConstituentMovedSolid();
     G4VG_ASSERT(underlying);
 
+    if (fold_reflections_)
+    {
+        if (ConvertFuncPtr reflect = find_reflector(*underlying))
+        {
+            // Construct the mirror image directly
+            return (this->*reflect)(*underlying);
+        }
+    }
+
     // Convert unreflected solid
     VUnplacedVolume const* converted = (*this)(*underlying);
 
     // Like the boolean solids, UnplacedScaledShape requires a logical volume
-    // under the hood: create temporary LV from converted solid
-    auto* temp_lv = new LogicalVolume(
-        make_temp_name(solid.GetName(), "refl").c_str(), converted);
-    // Place the transformed LV
+    // under the hood: create and place temporary LV from converted solid
     VPlacedVolume const* temp_placed
-        = temp_lv->Place(&Transformation3D::kIdentity);
+        = this->make_temp_pv(make_temp_name(solid.GetName(), "refl"),
+                             converted,
+                             Transformation3D::kIdentity);
 
     return GeoManager::MakeInstance<UnplacedScaledShape>(temp_placed, 1, 1, -1);
 }
@@ -585,8 +1121,21 @@ auto SolidConverter::sphere(arg_type solid_base) -> result_type
 //! Convert a subtraction solid
 auto SolidConverter::subtractionsolid(arg_type solid_base) -> result_type
 {
-    PlacedBoolVolumes pv = this->convert_bool_impl(
-        dynamic_cast<G4BooleanSolid const&>(solid_base));
+    auto const& solid = dynamic_cast<G4BooleanSolid const&>(solid_base);
+
+    if (simplify_booleans_)
+    {
+        G4VSolid const& minuend = *solid.GetConstituentSolid(0);
+        if (is_disjoint(bounding_box(minuend),
+                        bounding_box(*solid.GetConstituentSolid(1))))
+        {
+            // Nothing is removed from the minuend
+            ++num_pruned_booleans_;
+            return (*this)(minuend);
+        }
+    }
+
+    PlacedBoolVolumes pv = this->convert_bool_impl(solid);
     return make_unplaced_boolean<kSubtraction>(pv[0], pv[1]);
 }
 
@@ -596,31 +1145,81 @@ auto SolidConverter::tessellatedsolid(arg_type solid_base) -> result_type
 {
     auto const& solid = dynamic_cast<G4TessellatedSolid const&>(solid_base);
     using Vertex = vecgeom::Vector3D<vecgeom::Precision>;
-
-    auto* result = GeoManager::MakeInstance<UnplacedTessellated>();
-
-    for (int i = 0, imax = solid.GetNumberOfFacets(); i < imax; ++i)
+    using FacetIndices = std::array<int, 4>;
+
+    // Weld identical vertices into an indexed buffer
+    int const num_facets = solid.GetNumberOfFacets();
+    std::vector<G4ThreeVector> g4vertices;
+    std::vector<FacetIndices> facets;
+    std::unordered_map<VertexKey, int, VertexKeyHash> vertex_ids;
+    g4vertices.reserve(num_facets);
+    facets.reserve(num_facets);
+    vertex_ids.reserve(num_facets);
+    std::size_t num_refs = 0;
+    std::size_t num_degenerate = 0;
+    double const tolerance
+        = G4GeometryTolerance::GetInstance()->GetSurfaceTolerance();
+    for (int i = 0; i < num_facets; ++i)
     {
         G4VFacet const& facet = *solid.GetFacet(i);
         int const num_vtx = facet.GetNumberOfVertices();
-        std::array<Vertex, 4> vtx;
+        FacetIndices indices{{-1, -1, -1, -1}};
         for (int iv = 0; iv < num_vtx; ++iv)
         {
             auto vxg4 = facet.GetVertex(iv);
-            vtx[iv].Set(scale_(vxg4.x()), scale_(vxg4.y()), scale_(vxg4.z()));
+            auto [iter, inserted] = vertex_ids.insert(
+                {VertexKey{{vxg4.x(), vxg4.y(), vxg4.z()}},
+                 static_cast<int>(g4vertices.size())});
+            if (inserted)
+            {
+                g4vertices.push_back(vxg4);
+            }
+            indices[iv] = iter->second;
         }
+        num_refs += num_vtx;
 
-        if (num_vtx == 3)
+        int const num_welded = remove_repeated_vertices(indices, num_vtx);
+        if (num_welded == 0
+            || !has_area(g4vertices, indices, num_welded, tolerance))
         {
-            result->AddTriangularFacet(vtx[0], vtx[1], vtx[2], ABSOLUTE);
+            ++num_degenerate;
+            continue;
+        }
+        facets.push_back(indices);
+    }
+
+    // Scale each unique vertex once
+    std::vector<Vertex> vertices(g4vertices.size());
+    std::transform(g4vertices.begin(),
+                   g4vertices.end(),
+                   vertices.begin(),
+                   [this](G4ThreeVector const& v) { return scale_(v); });
+
+    auto* result = GeoManager::MakeInstance<UnplacedTessellated>();
+    std::size_t num_triangles = 0;
+    for (auto const& f : facets)
+    {
+        // Quadrilaterals are stored as two triangles
+        num_triangles += (f[3] < 0 ? 1 : 2);
+        if (f[3] < 0)
+        {
+            result->AddTriangularFacet(
+                vertices[f[0]], vertices[f[1]], vertices[f[2]], ABSOLUTE);
         }
         else
         {
-            result->AddQuadrilateralFacet(
-                vtx[0], vtx[1], vtx[2], vtx[3], ABSOLUTE);
+            result->AddQuadrilateralFacet(vertices[f[0]],
+                                          vertices[f[1]],
+                                          vertices[f[2]],
+                                          vertices[f[3]],
+                                          ABSOLUTE);
         }
     }
     result->Close();
+
+    num_welded_vertices_ += num_refs - vertices.size();
+    num_degenerate_facets_ += num_degenerate;
+    num_triangles_ += num_triangles;
     return result;
 }
 
@@ -717,11 +1316,172 @@ auto SolidConverter::tubs(arg_type solid_base) -> result_type
 //! Convert a union solid
 auto SolidConverter::unionsolid(arg_type solid_base) -> result_type
 {
-    PlacedBoolVolumes pv = this->convert_bool_impl(
-        dynamic_cast<G4BooleanSolid const&>(solid_base));
+    auto const& solid = dynamic_cast<G4BooleanSolid const&>(solid_base);
+
+    std::vector<TransformedSolid> components;
+    if (multiunion_threshold_ > 0 || simplify_booleans_)
+    {
+        flatten_union(solid, G4AffineTransform{}, &components);
+    }
+
+    if (multiunion_threshold_ > 0)
+    {
+        if (components.size() >= multiunion_threshold_)
+        {
+            // Replace the tree with a single flat union of all components
+            auto* result = GeoManager::MakeInstance<UnplacedMultiUnion>();
+            for (std::size_t i = 0; i < components.size(); ++i)
+            {
+                auto const& [component, affine] = components[i];
+                VUnplacedVolume const* converted = (*this)(*component);
+
+                std::string label
+                    = make_temp_name(solid.GetName(), std::to_string(i));
+                label += '/';
+                label += component->GetName();
+
+                result->AddNode(this->make_temp_pv(
+                    label, converted, transform_(affine)));
+            }
+            result->Close();
+            return result;
+        }
+    }
+
+    if (simplify_booleans_ && components.size() > 2)
+    {
+        // Find the depth of a balanced tree of the components
+        int min_depth = 0;
+        for (std::size_t n = components.size() - 1; n > 0; n >>= 1)
+        {
+            ++min_depth;
+        }
+        if (union_depth(solid) > min_depth)
+        {
+            // Rebuild the tree by recursively splitting the components
+            auto place = [this, &solid, &components](
+                             auto& self,
+                             std::size_t first,
+                             std::size_t last) -> VPlacedVolume const* {
+                std::string label = make_temp_name(
+                    solid.GetName(), std::to_string(first));
+                if (last - first == 1)
+                {
+                    auto const& [component, affine] = components[first];
+                    label += '/';
+                    label += component->GetName();
+                    return this->make_temp_pv(
+                        label, (*this)(*component), transform_(affine));
+                }
+                std::size_t const mid = first + (last - first) / 2;
+                auto* left = self(self, first, mid);
+                auto* right = self(self, mid, last);
+                label += '-';
+                label += std::to_string(last - 1);
+                return this->make_temp_pv(
+                    label,
+                    make_unplaced_boolean<kUnion>(left, right),
+                    Transformation3D::kIdentity);
+            };
+            std::size_t const mid = components.size() / 2;
+            auto* left = place(place, 0, mid);
+            auto* right = place(place, mid, components.size());
+            ++num_rebalanced_unions_;
+            return make_unplaced_boolean<kUnion>(left, right);
+        }
+    }
+
+    PlacedBoolVolumes pv = this->convert_bool_impl(solid);
     return make_unplaced_boolean<kUnion>(pv[0], pv[1]);
 }
 
+//---------------------------------------------------------------------------//
+// REFLECTED SOLIDS
+//---------------------------------------------------------------------------//
+//! Convert a solid that is its own mirror image in z
+auto SolidConverter::symmetric_z(arg_type solid) -> result_type
+{
+    return (*this)(solid);
+}
+
+//---------------------------------------------------------------------------//
+//! Convert the mirror image of a cone
+auto SolidConverter::reflected_cons(arg_type solid_base) -> result_type
+{
+    auto const& solid = dynamic_cast<G4Cons const&>(solid_base);
+    return GeoManager::MakeInstance<UnplacedCone>(
+        scale_(solid.GetInnerRadiusPlusZ()),
+        scale_(solid.GetOuterRadiusPlusZ()),
+        scale_(solid.GetInnerRadiusMinusZ()),
+        scale_(solid.GetOuterRadiusMinusZ()),
+        scale_(solid.GetZHalfLength()),
+        solid.GetStartPhiAngle(),
+        solid.GetDeltaPhiAngle());
+}
+
+//---------------------------------------------------------------------------//
+//! Convert the mirror image of a cut tube
+auto SolidConverter::reflected_cuttubs(arg_type solid_base) -> result_type
+{
+    auto const& solid = dynamic_cast<G4CutTubs const&>(solid_base);
+    // The high cut becomes the low cut and vice versa
+    G4ThreeVector lowNorm = solid.GetHighNorm();
+    G4ThreeVector hiNorm = solid.GetLowNorm();
+    return GeoManager::MakeInstance<UnplacedCutTube>(
+        scale_(solid.GetInnerRadius()),
+        scale_(solid.GetOuterRadius()),
+        scale_(solid.GetZHalfLength()),
+        solid.GetStartPhiAngle(),
+        solid.GetDeltaPhiAngle(),
+        Vector3D<Precision>(lowNorm[0], lowNorm[1], -lowNorm[2]),
+        Vector3D<Precision>(hiNorm[0], hiNorm[1], -hiNorm[2]));
+}
+
+//---------------------------------------------------------------------------//
+//! Convert the mirror image of a polycone
+auto SolidConverter::reflected_polycone(arg_type solid_base) -> result_type
+{
+    return this->polycone_impl(dynamic_cast<G4Polycone const&>(solid_base),
+                               /* reflect_z = */ true);
+}
+
+//---------------------------------------------------------------------------//
+//! Convert the mirror image of a polyhedron
+auto SolidConverter::reflected_polyhedra(arg_type solid_base) -> result_type
+{
+    return this->polyhedra_impl(dynamic_cast<G4Polyhedra const&>(solid_base),
+                                /* reflect_z = */ true);
+}
+
+//---------------------------------------------------------------------------//
+//! Convert the mirror image of a sphere
+auto SolidConverter::reflected_sphere(arg_type solid_base) -> result_type
+{
+    auto const& solid = dynamic_cast<G4Sphere const&>(solid_base);
+    double const end_theta
+        = solid.GetStartThetaAngle() + solid.GetDeltaThetaAngle();
+    return GeoManager::MakeInstance<UnplacedSphere>(
+        scale_(solid.GetInnerRadius()),
+        scale_(solid.GetOuterRadius()),
+        solid.GetStartPhiAngle(),
+        solid.GetDeltaPhiAngle(),
+        std::max(constants::pi - end_theta, 0.0),
+        solid.GetDeltaThetaAngle());
+}
+
+//---------------------------------------------------------------------------//
+//! Convert the mirror image of a simple trapezoid
+auto SolidConverter::reflected_trd(arg_type solid_base) -> result_type
+{
+    auto const& solid = dynamic_cast<G4Trd const&>(solid_base);
+    return GeoManager::MakeInstance<UnplacedTrd>(
+        scale_(solid.GetXHalfLength2()),
+        scale_(solid.GetXHalfLength1()),
+        scale_(solid.GetYHalfLength2()),
+        scale_(solid.GetYHalfLength1()),
+        scale_(solid.GetZHalfLength()));
+}
+
 //---------------------------------------------------------------------------//
 // HELPERS
 //---------------------------------------------------------------------------//
@@ -758,17 +1518,74 @@ auto SolidConverter::convert_bool_impl(G4BooleanSolid const& bs)
         label += '/';
         label += solid->GetName();
 
-        // Create temporary LV from converted solid
-        auto* temp_lv = new LogicalVolume(label.c_str(), converted);
-        // Place the transformed LV
-        result[i] = temp_lv->Place(trans ? trans.get()
-                                         : &Transformation3D::kIdentity);
+        // Create and place temporary LV from converted solid
+        result[i] = this->make_temp_pv(
+            label, converted, trans ? *trans : Transformation3D::kIdentity);
     }
 
     G4VG_ENSURE(result[0] && result[1]);
     return result;
 }
 
+//---------------------------------------------------------------------------//
+//! Create a temporary logical volume for a constituent solid
+auto SolidConverter::make_temp_lv(std::string const& label,
+                                  VUnplacedVolume const* unplaced)
+    -> LogicalVolume*
+{
+    ++num_temp_lvs_;
+    return new LogicalVolume(label.c_str(), unplaced);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Place a temporary volume for a constituent solid.
+ *
+ * VecGeom logical and placed volumes register themselves with the global
+ * geometry manager, which owns and deletes them and assigns their IDs, so
+ * they can't be allocated from a separate arena or kept out of the ID space.
+ * The converter instead reports the IDs of all temporary volumes. When
+ * pooling, a placement of the same solid with the same transform is reused,
+ * which avoids creating more volumes and IDs than needed. The label of the
+ * first placement is kept.
+ */
+auto SolidConverter::make_temp_pv(std::string const& label,
+                                  VUnplacedVolume const* unplaced,
+                                  Transformation3D const& trans)
+    -> VPlacedVolume const*
+{
+    G4VG_EXPECT(unplaced);
+
+    TempKey key;
+    if (pool_temp_)
+    {
+        key.unplaced = unplaced;
+        for (int i = 0; i < 3; ++i)
+        {
+            key.trans[i] = trans.Translation(i);
+        }
+        for (int i = 0; i < 9; ++i)
+        {
+            key.trans[3 + i] = trans.Rotation(i);
+        }
+        if (auto iter = temp_pvs_.find(key); iter != temp_pvs_.end())
+        {
+            ++num_pooled_;
+            return iter->second;
+        }
+    }
+
+    auto* temp_lv = this->make_temp_lv(label, unplaced);
+    VPlacedVolume const* result = temp_lv->Place(&trans);
+    G4VG_ASSERT(result);
+    temp_placed_.push_back(result);
+    if (pool_temp_)
+    {
+        temp_pvs_.insert({key, result});
+    }
+    return result;
+}
+
 //---------------------------------------------------------------------------//
 //! Compare volumes
 void SolidConverter::compare_volumes(G4VSolid const& g4,
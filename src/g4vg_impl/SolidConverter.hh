@@ -7,15 +7,27 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <typeindex>
 #include <unordered_map>
+#include <vector>
+
+#include "G4VG.hh"
+#include "PointerMap.hh"
 
 class G4BooleanSolid;
+class G4Polycone;
+class G4Polyhedra;
 class G4VSolid;
 
 namespace vecgeom
 {
 inline namespace cxx
 {
+class LogicalVolume;
+class Transformation3D;
 class VPlacedVolume;
 class VUnplacedVolume;
 }  // namespace cxx
@@ -25,6 +37,7 @@ namespace g4vg
 {
 //---------------------------------------------------------------------------//
 class Scaler;
+class TraceWriter;
 class Transformer;
 
 //---------------------------------------------------------------------------//
@@ -38,36 +51,156 @@ class SolidConverter
     //! \name Type aliases
     using arg_type = G4VSolid const&;
     using result_type = vecgeom::VUnplacedVolume*;
+    using VecSolid = std::vector<G4VSolid const*>;
+    using MapSolid = PointerMap<G4VSolid const*, result_type>;
+    using VecPlaced = std::vector<vecgeom::VPlacedVolume const*>;
     //!@}
 
   public:
     inline SolidConverter(Scaler const& convert_scale,
                           Transformer const& convert_transform,
-                          bool compare_volumes);
+                          Options const& options,
+                          TraceWriter* trace = nullptr);
 
     // Return a VecGeom-owned 'unplaced volume'
     result_type operator()(arg_type);
 
+    // Convert the primitive solids used by the given solids in parallel
+    void preconvert(VecSolid const& solids, unsigned int num_threads);
+
     // Return a sphere with equivalent capacity
     result_type to_sphere(arg_type) const;
 
+    //! Number of distinct Geant4 solids converted
+    std::size_t num_solids() const { return cache_.size(); }
+
+    //! Converted solids
+    MapSolid const& converted() const { return cache_; }
+
+    //! Number of solids that reused a structurally identical solid
+    std::size_t num_deduplicated() const { return num_deduplicated_; }
+
+    //! Number of temporary logical volumes created for composite solids
+    std::size_t num_temp_lvs() const { return num_temp_lvs_; }
+
+    //! Temporary placements created for composite solids
+    VecPlaced const& temp_placed() const { return temp_placed_; }
+
+    //! Number of temporary placements that reused an identical one
+    std::size_t num_pooled() const { return num_pooled_; }
+
+    //! Number of boolean operations removed by simplification
+    std::size_t num_pruned_booleans() const { return num_pruned_booleans_; }
+
+    //! Number of union trees rebuilt as balanced trees
+    std::size_t num_rebalanced_unions() const
+    {
+        return num_rebalanced_unions_;
+    }
+
+    //! Number of duplicate tessellated solid vertices that were merged
+    std::size_t num_welded_vertices() const { return num_welded_vertices_; }
+
+    //! Number of tessellated solid facets without area that were removed
+    std::size_t num_degenerate_facets() const
+    {
+        return num_degenerate_facets_;
+    }
+
+    //! Number of triangles in converted tessellated solids
+    std::size_t num_triangles() const { return num_triangles_; }
+
+    //! Conversion count and time by solid type (if statistics are enabled)
+    Statistics::MapSolidType const& type_stats() const { return type_stats_; }
+
   private:
     //// TYPES ////
 
+    using ConvertFuncPtr = result_type (SolidConverter::*)(arg_type);
     using PlacedBoolVolumes = std::array<vecgeom::VPlacedVolume const*, 2>;
 
+    //! Solid type and scaled parameters that uniquely define its shape
+    struct SolidKey
+    {
+        std::type_index type;
+        std::vector<double> params;
+
+        bool operator==(SolidKey const& other) const
+        {
+            return type == other.type && params == other.params;
+        }
+    };
+
+    struct SolidKeyHash
+    {
+        std::size_t operator()(SolidKey const&) const;
+    };
+
+    //! Solid and transform of a temporary placement
+    struct TempKey
+    {
+        vecgeom::VUnplacedVolume const* unplaced{nullptr};
+        std::array<double, 12> trans{};
+
+        bool operator==(TempKey const& other) const
+        {
+            return unplaced == other.unplaced && trans == other.trans;
+        }
+    };
+
+    struct TempKeyHash
+    {
+        std::size_t operator()(TempKey const&) const;
+    };
+
     //// DATA ////
 
     Scaler const& scale_;
     Transformer const& transform_;
     bool compare_volumes_;
-    std::unordered_map<G4VSolid const*, result_type> cache_;
+    bool deduplicate_;
+    bool statistics_;
+    unsigned int multiunion_threshold_;
+    bool pool_temp_;
+    bool fold_reflections_;
+    bool simplify_booleans_;
+    TraceWriter* trace_;
+    MapSolid cache_;
+    std::unordered_map<SolidKey, result_type, SolidKeyHash> unique_;
+    std::size_t num_deduplicated_{0};
+    std::size_t num_temp_lvs_{0};
+    std::size_t num_pooled_{0};
+    std::size_t num_pruned_booleans_{0};
+    std::size_t num_rebalanced_unions_{0};
+    std::unordered_map<TempKey, vecgeom::VPlacedVolume const*, TempKeyHash>
+        temp_pvs_;
+    VecPlaced temp_placed_;
+    result_type empty_box_{nullptr};
+    std::atomic<std::size_t> num_welded_vertices_{0};
+    std::atomic<std::size_t> num_degenerate_facets_{0};
+    std::atomic<std::size_t> num_triangles_{0};
+    Statistics::MapSolidType type_stats_;
 
     //// HELPER FUNCTIONS ////
 
     // Convert a solid that's not in the cache
     result_type convert_impl(arg_type);
 
+    // Convert a solid or reuse a structurally identical one
+    result_type convert_unique(arg_type);
+
+    // Construct a deduplication key (empty parameters if unsupported)
+    SolidKey make_key(arg_type) const;
+
+    // Find the member function that converts a solid type
+    static ConvertFuncPtr find_converter(arg_type);
+
+    // Find the member function that converts a solid's mirror image in z
+    static ConvertFuncPtr find_reflector(arg_type);
+
+    // Add the time to convert a solid to the statistics
+    void record_time(arg_type, double seconds);
+
     // Conversion functions
     result_type box(arg_type);
     result_type cons(arg_type);
@@ -97,8 +230,29 @@ class SolidConverter
     result_type tubs(arg_type);
     result_type unionsolid(arg_type);
 
+    // Reflected conversion functions
+    result_type symmetric_z(arg_type);
+    result_type reflected_cons(arg_type);
+    result_type reflected_cuttubs(arg_type);
+    result_type reflected_polycone(arg_type);
+    result_type reflected_polyhedra(arg_type);
+    result_type reflected_sphere(arg_type);
+    result_type reflected_trd(arg_type);
+
+    // Convert polycones and polyhedra, optionally mirrored in z
+    result_type polycone_impl(G4Polycone const&, bool reflect_z);
+    result_type polyhedra_impl(G4Polyhedra const&, bool reflect_z);
+
     // Construct bool daughters
     PlacedBoolVolumes convert_bool_impl(G4BooleanSolid const&);
+    // Create a temporary logical volume for a constituent solid
+    vecgeom::LogicalVolume*
+    make_temp_lv(std::string const& label, vecgeom::VUnplacedVolume const*);
+    // Place a temporary volume for a constituent solid
+    vecgeom::VPlacedVolume const*
+    make_temp_pv(std::string const& label,
+                 vecgeom::VUnplacedVolume const*,
+                 vecgeom::Transformation3D const&);
     // Compare volume/capacity of the solids
     void compare_volumes(G4VSolid const&, vecgeom::VUnplacedVolume const&);
     // Calculate solid capacity in native units
@@ -107,14 +261,22 @@ class SolidConverter
 
 //---------------------------------------------------------------------------//
 /*!
- * Construct with transform helper.
+ * Construct with transform helper and optional trace output.
  */
 SolidConverter::SolidConverter(Scaler const& convert_scale,
                                Transformer const& convert_transform,
-                               bool compare_volumes)
+                               Options const& options,
+                               TraceWriter* trace)
     : scale_(convert_scale)
     , transform_(convert_transform)
-    , compare_volumes_(compare_volumes)
+    , compare_volumes_(options.compare_volumes)
+    , deduplicate_(options.deduplicate_solids)
+    , statistics_(options.statistics)
+    , multiunion_threshold_(options.multiunion_threshold)
+    , pool_temp_(options.pool_temp_volumes)
+    , fold_reflections_(options.fold_reflections)
+    , simplify_booleans_(options.simplify_booleans)
+    , trace_(trace)
 {
 }
 
@@ -0,0 +1,156 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/SolidParameters.cc
+//---------------------------------------------------------------------------//
+#include "SolidParameters.hh"
+
+#include <typeindex>
+#include <typeinfo>
+#include <G4Box.hh>
+#include <G4Cons.hh>
+#include <G4Orb.hh>
+#include <G4Polycone.hh>
+#include <G4Polyhedra.hh>
+#include <G4Sphere.hh>
+#include <G4ThreeVector.hh>
+#include <G4Torus.hh>
+#include <G4Trap.hh>
+#include <G4Trd.hh>
+#include <G4Tubs.hh>
+
+#include "Scaler.hh"
+
+namespace g4vg
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Get the exact defining parameters of a common primitive solid.
+ *
+ * The result contains every parameter that the solid converter passes to
+ * VecGeom, with lengths scaled, so two solids of the same type with equal
+ * parameters are converted to identical unplaced volumes. The values are
+ * copied from the solid without rounding. Only common primitive solids are
+ * supported; other types return an empty vector.
+ */
+std::vector<double>
+solid_parameters(G4VSolid const& solid_base, Scaler const& scale)
+{
+    std::type_index const type{typeid(solid_base)};
+    std::vector<double> p;
+
+    if (type == typeid(G4Box))
+    {
+        auto const& solid = static_cast<G4Box const&>(solid_base);
+        p = {scale(solid.GetXHalfLength()),
+             scale(solid.GetYHalfLength()),
+             scale(solid.GetZHalfLength())};
+    }
+    else if (type == typeid(G4Cons))
+    {
+        auto const& solid = static_cast<G4Cons const&>(solid_base);
+        p = {scale(solid.GetInnerRadiusMinusZ()),
+             scale(solid.GetOuterRadiusMinusZ()),
+             scale(solid.GetInnerRadiusPlusZ()),
+             scale(solid.GetOuterRadiusPlusZ()),
+             scale(solid.GetZHalfLength()),
+             solid.GetStartPhiAngle(),
+             solid.GetDeltaPhiAngle()};
+    }
+    else if (type == typeid(G4Orb))
+    {
+        auto const& solid = static_cast<G4Orb const&>(solid_base);
+        p = {scale(solid.GetRadius())};
+    }
+    else if (type == typeid(G4Polycone))
+    {
+        auto const& solid = static_cast<G4Polycone const&>(solid_base);
+        auto const& params = *solid.GetOriginalParameters();
+        p = {params.Start_angle,
+             params.Opening_angle,
+             static_cast<double>(params.Num_z_planes)};
+        for (int i = 0; i < params.Num_z_planes; ++i)
+        {
+            p.insert(p.end(),
+                     {scale(params.Z_values[i]),
+                      scale(params.Rmin[i]),
+                      scale(params.Rmax[i])});
+        }
+    }
+    else if (type == typeid(G4Polyhedra))
+    {
+        auto const& solid = static_cast<G4Polyhedra const&>(solid_base);
+        auto const& params = *solid.GetOriginalParameters();
+        p = {params.Start_angle,
+             params.Opening_angle,
+             static_cast<double>(params.numSide),
+             static_cast<double>(params.Num_z_planes)};
+        for (int i = 0; i < params.Num_z_planes; ++i)
+        {
+            p.insert(p.end(),
+                     {scale(params.Z_values[i]),
+                      scale(params.Rmin[i]),
+                      scale(params.Rmax[i])});
+        }
+    }
+    else if (type == typeid(G4Sphere))
+    {
+        auto const& solid = static_cast<G4Sphere const&>(solid_base);
+        p = {scale(solid.GetInnerRadius()),
+             scale(solid.GetOuterRadius()),
+             solid.GetStartPhiAngle(),
+             solid.GetDeltaPhiAngle(),
+             solid.GetStartThetaAngle(),
+             solid.GetDeltaThetaAngle()};
+    }
+    else if (type == typeid(G4Torus))
+    {
+        auto const& solid = static_cast<G4Torus const&>(solid_base);
+        p = {scale(solid.GetRmin()),
+             scale(solid.GetRmax()),
+             scale(solid.GetRtor()),
+             solid.GetSPhi(),
+             solid.GetDPhi()};
+    }
+    else if (type == typeid(G4Trap))
+    {
+        auto const& solid = static_cast<G4Trap const&>(solid_base);
+        G4ThreeVector const axis = solid.GetSymAxis();
+        p = {scale(solid.GetZHalfLength()),
+             axis.x(),
+             axis.y(),
+             axis.z(),
+             scale(solid.GetYHalfLength1()),
+             scale(solid.GetXHalfLength1()),
+             scale(solid.GetXHalfLength2()),
+             solid.GetTanAlpha1(),
+             scale(solid.GetYHalfLength2()),
+             scale(solid.GetXHalfLength3()),
+             scale(solid.GetXHalfLength4()),
+             solid.GetTanAlpha2()};
+    }
+    else if (type == typeid(G4Trd))
+    {
+        auto const& solid = static_cast<G4Trd const&>(solid_base);
+        p = {scale(solid.GetXHalfLength1()),
+             scale(solid.GetXHalfLength2()),
+             scale(solid.GetYHalfLength1()),
+             scale(solid.GetYHalfLength2()),
+             scale(solid.GetZHalfLength())};
+    }
+    else if (type == typeid(G4Tubs))
+    {
+        auto const& solid = static_cast<G4Tubs const&>(solid_base);
+        p = {scale(solid.GetInnerRadius()),
+             scale(solid.GetOuterRadius()),
+             scale(solid.GetZHalfLength()),
+             solid.GetStartPhiAngle(),
+             solid.GetDeltaPhiAngle()};
+    }
+
+    return p;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
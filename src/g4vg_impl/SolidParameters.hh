@@ -0,0 +1,24 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/SolidParameters.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <vector>
+
+class G4VSolid;
+
+namespace g4vg
+{
+//---------------------------------------------------------------------------//
+class Scaler;
+
+//---------------------------------------------------------------------------//
+// Get the exact defining parameters of a common primitive solid
+std::vector<double>
+solid_parameters(G4VSolid const& solid, Scaler const& scale);
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
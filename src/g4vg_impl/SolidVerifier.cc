@@ -0,0 +1,132 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/SolidVerifier.cc
+//---------------------------------------------------------------------------//
+#include "SolidVerifier.hh"
+
+#include <functional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <G4ThreeVector.hh>
+#include <G4VSolid.hh>
+#include <VecGeom/volumes/UnplacedVolume.h>
+
+#include "Assert.hh"
+#include "GeantWorkspace.hh"
+#include "Logger.hh"
+#include "ParallelFor.hh"
+#include "Scaler.hh"
+
+namespace g4vg
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Construct with scale, samples per solid, and threads.
+ */
+SolidVerifier::SolidVerifier(Scaler const& convert_scale,
+                             unsigned int num_samples,
+                             unsigned int num_threads)
+    : scale_{convert_scale}
+    , num_samples_{num_samples}
+    , num_threads_{num_threads}
+{
+    G4VG_EXPECT(num_samples_ > 0);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Verify solids and add the results to per-type statistics.
+ *
+ * A warning is printed for every solid with mismatched points.
+ */
+void SolidVerifier::operator()(MapSolid const& solids,
+                               Statistics::MapSolidType* type_stats) const
+{
+    G4VG_EXPECT(type_stats);
+
+    std::vector<std::pair<G4VSolid const*, VUnplacedVolume const*>> items(
+        solids.begin(), solids.end());
+    std::vector<Result> results(items.size());
+
+    G4VG_LOG(debug) << "Verifying " << items.size() << " solids with "
+                    << num_samples_ << " points each";
+    // Some solids use per-thread data (e.g., phi caches) inside Geant4
+    unsigned int const num_threads
+        = resolve_geant_threads(num_threads_, "verifying solids");
+    parallel_for_scoped<GeantWorkspace>(
+        items.size(), num_threads, [&](std::size_t i) {
+            G4VG_ASSERT(items[i].first && items[i].second);
+            results[i] = this->verify(*items[i].first, *items[i].second);
+        });
+
+    std::size_t num_bad{0};
+    for (std::size_t i = 0; i != items.size(); ++i)
+    {
+        G4VSolid const& g4 = *items[i].first;
+        Result const& r = results[i];
+        auto& stats = (*type_stats)[g4.GetEntityType()];
+        stats.samples += r.samples;
+        stats.mismatches += r.mismatches;
+
+        if (r.mismatches > 0)
+        {
+            ++num_bad;
+            G4VG_LOG(warning)
+                << "Solid '" << g4.GetName() << "' of type '"
+                << g4.GetEntityType() << "' disagrees with VecGeom at "
+                << r.mismatches << " of " << r.samples << " sampled points";
+        }
+    }
+
+    if (num_bad == 0)
+    {
+        G4VG_LOG(info) << "Verified " << items.size() << " converted solids";
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Sample points in a single solid.
+ */
+auto SolidVerifier::verify(G4VSolid const& g4, VUnplacedVolume const& vg) const
+    -> Result
+{
+    G4ThreeVector lower;
+    G4ThreeVector upper;
+    g4.BoundingLimits(lower, upper);
+
+    std::mt19937_64 rng(std::hash<std::string>{}(g4.GetName()));
+    std::uniform_real_distribution<double> sample_x(lower.x(), upper.x());
+    std::uniform_real_distribution<double> sample_y(lower.y(), upper.y());
+    std::uniform_real_distribution<double> sample_z(lower.z(), upper.z());
+
+    Result result;
+    for (unsigned int i = 0; i != num_samples_; ++i)
+    {
+        G4ThreeVector const pos{sample_x(rng), sample_y(rng), sample_z(rng)};
+
+        EInside const g4_inside = g4.Inside(pos);
+        auto const vg_inside = vg.Inside(scale_(pos));
+        if (g4_inside == EInside::kSurface
+            || vg_inside == vecgeom::EInside::kSurface)
+        {
+            // Don't compare points within the tolerance of either library
+            continue;
+        }
+
+        ++result.samples;
+        if ((g4_inside == EInside::kInside)
+            != (vg_inside == vecgeom::EInside::kInside))
+        {
+            ++result.mismatches;
+        }
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
@@ -0,0 +1,77 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/SolidVerifier.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <cstddef>
+
+#include "G4VG.hh"
+#include "PointerMap.hh"
+
+class G4VSolid;
+
+namespace vecgeom
+{
+inline namespace cxx
+{
+class VUnplacedVolume;
+}  // namespace cxx
+}  // namespace vecgeom
+
+namespace g4vg
+{
+//---------------------------------------------------------------------------//
+class Scaler;
+
+//---------------------------------------------------------------------------//
+/*!
+ * Compare converted solids against Geant4 by sampling points.
+ *
+ * Uniformly random points in the bounding box of each Geant4 solid are
+ * classified by both \c G4VSolid::Inside and \c VUnplacedVolume::Inside .
+ * Points that either one reports as on the surface are ignored, since the
+ * two libraries use different tolerances. Unlike the capacity comparison,
+ * this works for boolean solids and never invokes Geant4's Monte Carlo volume
+ * estimate. Solids are verified in parallel and the random sequence for each
+ * solid depends only on its name, so results are reproducible.
+ */
+class SolidVerifier
+{
+  public:
+    //!@{
+    //! \name Type aliases
+    using VUnplacedVolume = vecgeom::VUnplacedVolume;
+    using MapSolid = PointerMap<G4VSolid const*, VUnplacedVolume*>;
+    //!@}
+
+  public:
+    // Construct with scale, samples per solid, and threads
+    SolidVerifier(Scaler const& convert_scale,
+                  unsigned int num_samples,
+                  unsigned int num_threads);
+
+    // Verify solids and add the results to per-type statistics
+    void operator()(MapSolid const& solids,
+                    Statistics::MapSolidType* type_stats) const;
+
+  private:
+    //! Number of compared and mismatched points for one solid
+    struct Result
+    {
+        std::size_t samples{0};
+        std::size_t mismatches{0};
+    };
+
+    Scaler const& scale_;
+    unsigned int num_samples_;
+    unsigned int num_threads_;
+
+    // Sample points in a single solid
+    Result verify(G4VSolid const&, VUnplacedVolume const&) const;
+};
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
@@ -0,0 +1,43 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/Stopwatch.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <chrono>
+
+namespace g4vg
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Simple timer that starts on construction.
+ *
+ * \code
+   Stopwatch get_time;
+   do_something();
+   double elapsed = get_time();
+ * \endcode
+ */
+class Stopwatch
+{
+  public:
+    //! Start the timer
+    Stopwatch() : start_{Clock::now()} {}
+
+    //! Get the wall time elapsed since construction, in seconds
+    double operator()() const
+    {
+        using DurationSec = std::chrono::duration<double>;
+        return std::chrono::duration_cast<DurationSec>(Clock::now() - start_)
+            .count();
+    }
+
+  private:
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start_;
+};
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
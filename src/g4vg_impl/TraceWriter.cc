@@ -0,0 +1,150 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/TraceWriter.cc
+//---------------------------------------------------------------------------//
+#include "TraceWriter.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+
+#include "Assert.hh"
+
+namespace g4vg
+{
+namespace
+{
+//---------------------------------------------------------------------------//
+//! Write a string as a quoted JSON string
+void write_json_string(std::ostream& os, std::string_view s)
+{
+    os << '"';
+    for (char c : s)
+    {
+        switch (c)
+        {
+            case '"':
+                os << "\\\"";
+                break;
+            case '\\':
+                os << "\\\\";
+                break;
+            case '\n':
+                os << "\\n";
+                break;
+            case '\t':
+                os << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    os << buf;
+                }
+                else
+                {
+                    os << c;
+                }
+        }
+    }
+    os << '"';
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace
+
+//---------------------------------------------------------------------------//
+/*!
+ * Open the output file.
+ */
+TraceWriter::TraceWriter(std::string const& filename)
+    : out_{filename}, origin_{Clock::now()}
+{
+    G4VG_VALIDATE(out_, << "failed to open trace file '" << filename << "'");
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Record a completed span.
+ *
+ * This is thread safe.
+ */
+void TraceWriter::record(std::string name,
+                         char const* category,
+                         Clock::time_point start,
+                         Clock::time_point stop,
+                         VecArg args)
+{
+    using DurationUs = std::chrono::duration<double, std::micro>;
+
+    Event event;
+    event.name = std::move(name);
+    event.category = category;
+    event.start = DurationUs(start - origin_).count();
+    event.duration = DurationUs(stop - start).count();
+    event.args = std::move(args);
+
+    std::lock_guard<std::mutex> lock{mutex_};
+    auto [iter, inserted] = threads_.insert(
+        {std::this_thread::get_id(), static_cast<int>(threads_.size())});
+    event.thread = iter->second;
+    events_.push_back(std::move(event));
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Write all recorded spans and close the file.
+ *
+ * Events are sorted by start time (longest first for equal starts) so that
+ * enclosing spans precede the spans they contain.
+ */
+void TraceWriter::write()
+{
+    std::lock_guard<std::mutex> lock{mutex_};
+    std::stable_sort(
+        events_.begin(), events_.end(), [](Event const& a, Event const& b) {
+            if (a.start != b.start)
+            {
+                return a.start < b.start;
+            }
+            return a.duration > b.duration;
+        });
+
+    out_ << std::fixed << std::setprecision(3);
+    out_ << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    char const* sep = "\n";
+    for (Event const& e : events_)
+    {
+        out_ << sep << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << e.thread
+             << ",\"ts\":" << e.start << ",\"dur\":" << e.duration
+             << ",\"cat\":";
+        write_json_string(out_, e.category);
+        out_ << ",\"name\":";
+        write_json_string(out_, e.name);
+        if (!e.args.empty())
+        {
+            out_ << ",\"args\":{";
+            char const* arg_sep = "";
+            for (auto const& [key, value] : e.args)
+            {
+                out_ << arg_sep;
+                write_json_string(out_, key);
+                out_ << ':';
+                write_json_string(out_, value);
+                arg_sep = ",";
+            }
+            out_ << '}';
+        }
+        out_ << '}';
+        sep = ",\n";
+    }
+    out_ << "\n]}\n";
+    out_.close();
+    G4VG_VALIDATE(!out_.fail(), << "failed to write trace file");
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
@@ -0,0 +1,160 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/TraceWriter.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace g4vg
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Record timed spans and write them as a Chrome trace event file.
+ *
+ * The output can be loaded into \c chrome://tracing or the Perfetto UI. Each
+ * span is a "complete" event with a name, category, start time, duration,
+ * and optional string arguments. Spans may be recorded from multiple
+ * threads; each thread is shown as a separate track.
+ *
+ * The file is opened on construction so that a bad path is reported before
+ * the conversion starts.
+ */
+class TraceWriter
+{
+  public:
+    //!@{
+    //! \name Type aliases
+    using Clock = std::chrono::steady_clock;
+    using VecArg = std::vector<std::pair<char const*, std::string>>;
+    //!@}
+
+  public:
+    // Open the output file
+    explicit TraceWriter(std::string const& filename);
+
+    // Record a completed span
+    void record(std::string name,
+                char const* category,
+                Clock::time_point start,
+                Clock::time_point stop,
+                VecArg args);
+
+    // Write all recorded spans and close the file
+    void write();
+
+  private:
+    struct Event
+    {
+        std::string name;
+        char const* category;
+        double start;  //!< [us]
+        double duration;  //!< [us]
+        int thread;
+        VecArg args;
+    };
+
+    std::ofstream out_;
+    Clock::time_point origin_;
+    std::mutex mutex_;
+    std::unordered_map<std::thread::id, int> threads_;
+    std::vector<Event> events_;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Record a trace span for the lifetime of this object.
+ *
+ * This does nothing (and doesn't copy the name) if the writer is null.
+ */
+class TraceSpan
+{
+  public:
+    // Start the span
+    inline TraceSpan(TraceWriter* trace,
+                     std::string_view name,
+                     char const* category);
+
+    // Record the span
+    inline ~TraceSpan();
+
+    //! Add a string argument shown with the span
+    void arg(char const* key, std::string value)
+    {
+        if (trace_)
+        {
+            args_.emplace_back(key, std::move(value));
+        }
+    }
+
+    //! Whether the span is being recorded
+    explicit operator bool() const { return trace_ != nullptr; }
+
+    TraceSpan(TraceSpan const&) = delete;
+    TraceSpan& operator=(TraceSpan const&) = delete;
+
+    //! Take over recording a span (e.g. when stored in a vector)
+    TraceSpan(TraceSpan&& other) noexcept
+        : trace_{std::exchange(other.trace_, nullptr)}
+        , name_{std::move(other.name_)}
+        , category_{other.category_}
+        , start_{other.start_}
+        , args_{std::move(other.args_)}
+    {
+    }
+    TraceSpan& operator=(TraceSpan&&) = delete;
+
+  private:
+    TraceWriter* trace_;
+    std::string name_;
+    char const* category_;
+    TraceWriter::Clock::time_point start_;
+    TraceWriter::VecArg args_;
+};
+
+//---------------------------------------------------------------------------//
+// INLINE DEFINITIONS
+//---------------------------------------------------------------------------//
+/*!
+ * Start the span.
+ */
+TraceSpan::TraceSpan(TraceWriter* trace,
+                     std::string_view name,
+                     char const* category)
+    : trace_{trace}, category_{category}
+{
+    if (trace_)
+    {
+        name_ = name;
+        start_ = TraceWriter::Clock::now();
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Record the span.
+ */
+TraceSpan::~TraceSpan()
+{
+    if (trace_)
+    {
+        trace_->record(std::move(name_),
+                       category_,
+                       start_,
+                       TraceWriter::Clock::now(),
+                       std::move(args_));
+    }
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
@@ -0,0 +1,261 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/Transformer.cc
+//---------------------------------------------------------------------------//
+#include "Transformer.hh"
+
+#include <cmath>
+#include <cstring>
+
+#include "HashCombine.hh"
+#include "MemoryUsage.hh"
+
+namespace g4vg
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Return the shared transform equivalent to the given one.
+ *
+ * If a previously interned transform matches (to within the tolerance), a
+ * reference to the earliest such transform is returned; otherwise the
+ * transform is stored. References remain valid for the lifetime of this
+ * object.
+ *
+ * With a nonzero tolerance, stored transforms are binned by a grid of
+ * tolerance-sized cells in translation space. Any transform within the
+ * tolerance must lie in the same or an adjacent cell, so only those 27 cells
+ * are searched, and each candidate is compared component by component.
+ */
+auto Transformer::intern(result_type const& trans) -> result_type const&
+{
+    if (tolerance_ == 0)
+    {
+        auto [iter, inserted]
+            = exact_.insert({this->make_key(trans), interned_.size()});
+        if (!inserted)
+        {
+            return interned_[iter->second];
+        }
+        return this->insert(trans);
+    }
+
+    Cell const cell = this->make_cell(trans);
+    std::size_t found = interned_.size();
+    for (int i = 0; i < 27; ++i)
+    {
+        Cell neighbor;
+        for (int ax = 0, offset = i; ax < 3; ++ax, offset /= 3)
+        {
+            neighbor[ax] = cell[ax] + offset % 3 - 1;
+        }
+        auto iter = cells_.find(neighbor);
+        if (iter == cells_.end())
+        {
+            continue;
+        }
+        // Indices in a cell are increasing, so the first match is earliest
+        for (std::size_t idx : iter->second)
+        {
+            if (idx >= found)
+            {
+                break;
+            }
+            if (this->is_close(trans, interned_[idx]))
+            {
+                found = idx;
+                break;
+            }
+        }
+    }
+    if (found != interned_.size())
+    {
+        return interned_[found];
+    }
+
+    cells_[cell].push_back(interned_.size());
+    return this->insert(trans);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Classify a transform by its components.
+ */
+auto Transformer::classify(result_type const& trans) -> Kind
+{
+    bool const has_rot = trans.HasRotation();
+    bool const has_trans = trans.HasTranslation();
+    if (has_rot)
+    {
+        return has_trans ? Kind::general : Kind::rotation;
+    }
+    return has_trans ? Kind::translation : Kind::identity;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Whether a transform's rotation only permutes and flips axes.
+ *
+ * Each row of such a matrix has exactly one nonzero entry, which is +-1.
+ * Transforms without a rotation are not counted.
+ */
+bool Transformer::is_permutation(result_type const& trans)
+{
+    if (!trans.HasRotation())
+    {
+        return false;
+    }
+    for (int row = 0; row < 3; ++row)
+    {
+        int num_unit = 0;
+        for (int col = 0; col < 3; ++col)
+        {
+            double const v = trans.Rotation(3 * row + col);
+            if (v == 1 || v == -1)
+            {
+                ++num_unit;
+            }
+            else if (v != 0)
+            {
+                return false;
+            }
+        }
+        if (num_unit != 1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Construct a key from the bits of the translation and rotation components.
+ *
+ * The sign of zero is ignored.
+ */
+auto Transformer::make_key(result_type const& trans) const -> Key
+{
+    auto to_int = [](double v) -> std::int64_t {
+        if (v == 0)
+        {
+            // Treat negative zero like positive zero
+            v = 0;
+        }
+        std::int64_t result;
+        std::memcpy(&result, &v, sizeof(result));
+        return result;
+    };
+
+    Key result;
+    for (int i = 0; i < 3; ++i)
+    {
+        result[i] = to_int(trans.Translation(i));
+    }
+    for (int i = 0; i < 9; ++i)
+    {
+        result[3 + i] = to_int(trans.Rotation(i));
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Find the tolerance-sized grid cell containing the translation.
+ */
+auto Transformer::make_cell(result_type const& trans) const -> Cell
+{
+    G4VG_EXPECT(tolerance_ > 0);
+
+    // Leave room for the neighboring cells
+    constexpr double max_cell = 0x1p62;
+
+    Cell result;
+    for (int i = 0; i < 3; ++i)
+    {
+        double const v = trans.Translation(i);
+        double const cell = std::floor(v / tolerance_);
+        G4VG_VALIDATE(std::fabs(cell) < max_cell,
+                      << "translation component " << v
+                      << " is too large for the transform tolerance "
+                      << tolerance_);
+        result[i] = static_cast<std::int64_t>(cell);
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Whether all components of two transforms are within the tolerance.
+ */
+bool Transformer::is_close(result_type const& a, result_type const& b) const
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        if (!(std::fabs(a.Translation(i) - b.Translation(i)) <= tolerance_))
+        {
+            return false;
+        }
+    }
+    for (int i = 0; i < 9; ++i)
+    {
+        if (!(std::fabs(a.Rotation(i) - b.Rotation(i)) <= tolerance_))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Store and classify a new distinct transform.
+ */
+auto Transformer::insert(result_type const& trans) -> result_type const&
+{
+    interned_.push_back(trans);
+    ++kind_counts_[static_cast<int>(classify(trans))];
+    if (is_permutation(trans))
+    {
+        ++num_permutations_;
+    }
+    return interned_.back();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Hash a transform key or grid cell.
+ */
+template<std::size_t N>
+std::size_t
+Transformer::KeyHash::operator()(std::array<std::int64_t, N> const& key) const
+{
+    std::size_t result = 0;
+    for (std::int64_t v : key)
+    {
+        hash_combine(result, v);
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Estimate the memory used by interned transforms.
+ */
+Statistics::MemoryUsage Transformer::memory_usage() const
+{
+    Statistics::MemoryUsage result;
+    result.count = interned_.size();
+    result.bytes = interned_.size() * sizeof(result_type)
+                   + hash_container_usage(exact_).bytes
+                   + hash_container_usage(cells_).bytes;
+    for (auto const& kv : cells_)
+    {
+        result.bytes += kv.second.capacity() * sizeof(std::size_t);
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
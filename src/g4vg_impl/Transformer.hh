@@ -6,11 +6,19 @@
 //---------------------------------------------------------------------------//
 #pragma once
 
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
 #include <G4AffineTransform.hh>
 #include <G4RotationMatrix.hh>
 #include <G4ThreeVector.hh>
 #include <VecGeom/base/Transformation3D.h>
 
+#include "G4VG.hh"
 #include "Scaler.hh"
 
 namespace g4vg
@@ -18,6 +26,22 @@ namespace g4vg
 //---------------------------------------------------------------------------//
 /*!
  * Return a VecGeom transformation from a Geant4 transformation.
+ *
+ * Placement transforms can also be \em interned : a transform whose
+ * translation and rotation components all differ by no more than a tolerance
+ * from those of a previously interned transform is replaced by the first such
+ * transform. With a zero tolerance only bitwise identical transforms (up to
+ * the sign of zero) are shared. Each distinct transform is classified by
+ * whether it has a translation and/or a rotation. VecGeom copies each
+ * transform into its placed volume, so interning saves no memory: it makes
+ * nearly identical placements exactly identical and provides the transform
+ * statistics. Interning is not thread safe.
+ *
+ * Rotation matrix elements within \c snap_tolerance of 0 or +-1 are rounded to
+ * those exact values. Rotations that are then the identity are dropped, so
+ * that VecGeom recognizes translation-only placements, and axis permutations
+ * (including 90-degree turns and reflections) have the exact entries VecGeom
+ * needs to select its specialized rotation kernels.
  */
 class Transformer
 {
@@ -27,9 +51,25 @@ class Transformer
     using result_type = vecgeom::Transformation3D;
     //!@}
 
+    //! Components of a transform
+    enum class Kind
+    {
+        identity,
+        translation,
+        rotation,
+        general,
+        size_
+    };
+
+    using KindCounts = std::array<std::size_t, static_cast<int>(Kind::size_)>;
+
+    //! Maximum round-off in a rotation matrix element that's snapped
+    static constexpr double snap_tolerance = 1e-12;
+
   public:
-    // Construct with a scale
-    inline explicit Transformer(Scaler const& convert_scale_);
+    // Construct with a scale and interning tolerance
+    inline explicit Transformer(Scaler const& convert_scale_,
+                                double tolerance = 0);
 
     //! Convert a translation
     inline result_type operator()(G4ThreeVector const& t) const;
@@ -45,21 +85,94 @@ class Transformer
     //! Convert an affine transform
     inline result_type operator()(G4AffineTransform const& at) const;
 
+    // Return the shared transform equivalent to the given one
+    result_type const& intern(result_type const& trans);
+
+    // Classify a transform by its components
+    static Kind classify(result_type const& trans);
+
+    // Whether a transform's rotation only permutes and flips axes
+    static bool is_permutation(result_type const& trans);
+
+    //! Number of distinct interned transforms
+    std::size_t num_distinct() const { return interned_.size(); }
+
+    //! Interning tolerance
+    double tolerance() const { return tolerance_; }
+
+    //! Number of interned transforms of each kind
+    KindCounts const& kind_counts() const { return kind_counts_; }
+
+    //! Number of interned transforms with an axis permutation rotation
+    std::size_t num_permutations() const { return num_permutations_; }
+
+    // Estimate the memory used by interned transforms
+    Statistics::MemoryUsage memory_usage() const;
+
   private:
+    //// TYPES ////
+
+    //! Bit patterns of all components, for exact matching
+    using Key = std::array<std::int64_t, 12>;
+    //! Index of the tolerance-sized grid cell containing the translation
+    using Cell = std::array<std::int64_t, 3>;
+
+    struct KeyHash
+    {
+        template<std::size_t N>
+        std::size_t operator()(std::array<std::int64_t, N> const&) const;
+    };
+
     //// DATA ////
 
     Scaler const& convert_scale_;
+    double tolerance_;
+    std::deque<result_type> interned_;
+    std::unordered_map<Key, std::size_t, KeyHash> exact_;
+    std::unordered_map<Cell, std::vector<std::size_t>, KeyHash> cells_;
+    KindCounts kind_counts_{};
+    std::size_t num_permutations_{0};
+
+    //// HELPER FUNCTIONS ////
+
+    Key make_key(result_type const& trans) const;
+    Cell make_cell(result_type const& trans) const;
+    bool is_close(result_type const& a, result_type const& b) const;
+    result_type const& insert(result_type const& trans);
 };
 
+//---------------------------------------------------------------------------//
+// FREE FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * Round a rotation matrix element that's very close to 0 or +-1.
+ */
+inline double snap_unit(double v)
+{
+    double const nearest = std::round(v);
+    if (std::fabs(nearest) <= 1
+        && std::fabs(v - nearest) <= Transformer::snap_tolerance)
+    {
+        // Avoid negative zero
+        return nearest + 0.0;
+    }
+    return v;
+}
+
 //---------------------------------------------------------------------------//
 // INLINE DEFINITIONS
 //---------------------------------------------------------------------------//
 /*!
- * Construct with a scaling function.
+ * Construct with a scaling function and interning tolerance.
+ *
+ * The tolerance is absolute for both the (native unit) translation and the
+ * rotation matrix elements. A zero tolerance shares only identical transforms.
  */
-Transformer::Transformer(Scaler const& convert_scale)
-    : convert_scale_{convert_scale}
+Transformer::Transformer(Scaler const& convert_scale, double tolerance)
+    : convert_scale_{convert_scale}, tolerance_{tolerance}
 {
+    G4VG_VALIDATE(tolerance_ >= 0 && std::isfinite(tolerance_),
+                  << "invalid transform tolerance " << tolerance_);
 }
 
 //---------------------------------------------------------------------------//
@@ -74,22 +187,38 @@ auto Transformer::operator()(G4ThreeVector const& t) const -> result_type
 //---------------------------------------------------------------------------//
 /*!
  * Create a transform from a translation plus rotation.
+ *
+ * The rotation is omitted if it's the identity after snapping.
  */
 auto Transformer::operator()(G4ThreeVector const& t,
                              G4RotationMatrix const& rot) const -> result_type
 {
+    std::array<double, 9> const r{snap_unit(rot.xx()),
+                                  snap_unit(rot.yx()),
+                                  snap_unit(rot.zx()),
+                                  snap_unit(rot.xy()),
+                                  snap_unit(rot.yy()),
+                                  snap_unit(rot.zy()),
+                                  snap_unit(rot.xz()),
+                                  snap_unit(rot.yz()),
+                                  snap_unit(rot.zz())};
+    if (r == std::array<double, 9>{1, 0, 0, 0, 1, 0, 0, 0, 1})
+    {
+        return (*this)(t);
+    }
+
     return {convert_scale_(t[0]),
             convert_scale_(t[1]),
             convert_scale_(t[2]),
-            rot.xx(),
-            rot.yx(),
-            rot.zx(),
-            rot.xy(),
-            rot.yy(),
-            rot.zy(),
-            rot.xz(),
-            rot.yz(),
-            rot.zz()};
+            r[0],
+            r[1],
+            r[2],
+            r[3],
+            r[4],
+            r[5],
+            r[6],
+            r[7],
+            r[8]};
 }
 
 //---------------------------------------------------------------------------//
@@ -0,0 +1,52 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/VolumeIndex.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <functional>
+#include <tuple>
+
+#include "G4VG.hh"
+
+namespace g4vg
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Order logical volume index entries by Geant4 pointer.
+ */
+struct LvIndexLess
+{
+    using Entry = Converted::LvIndexEntry;
+
+    bool operator()(Entry const& a, Entry const& b) const
+    {
+        return std::less<G4LogicalVolume const*>{}(a.lv, b.lv);
+    }
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Order physical volume index entries by Geant4 pointer, copy, and ID.
+ *
+ * Including the ID means that the first match of a search for a pointer and
+ * copy number with a zero ID is the lowest ID.
+ */
+struct PvIndexLess
+{
+    using Entry = Converted::PvIndexEntry;
+
+    bool operator()(Entry const& a, Entry const& b) const
+    {
+        if (a.pv != b.pv)
+        {
+            return std::less<G4VPhysicalVolume const*>{}(a.pv, b.pv);
+        }
+        return std::tie(a.copy_no, a.id) < std::tie(b.copy_no, b.id);
+    }
+};
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
@@ -0,0 +1,399 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/VoxelGridConverter.cc
+//---------------------------------------------------------------------------//
+#include "VoxelGridConverter.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <G4Box.hh>
+#include <G4LogicalVolume.hh>
+#include <G4Material.hh>
+#include <G4PhantomParameterisation.hh>
+#include <G4VNestedParameterisation.hh>
+#include <G4VPVParameterisation.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4VTouchable.hh>
+
+#include "Assert.hh"
+#include "Scaler.hh"
+
+namespace g4vg
+{
+namespace
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Touchable history for calculating the material of a nested voxel.
+ *
+ * Nested parameterisations look up the material using the copy numbers of
+ * the two enclosing replicas.
+ */
+class VoxelTouchable final : public G4VTouchable
+{
+  public:
+    //! Copy numbers of the inner (depth 0) and outer (depth 1) replicas
+    std::array<int, 2> replica{{0, 0}};
+
+    G4ThreeVector const& GetTranslation(G4int) const final
+    {
+        return origin_;
+    }
+    G4RotationMatrix const* GetRotation(G4int) const final { return nullptr; }
+    G4int GetReplicaNumber(G4int depth) const final
+    {
+        return depth < 2 ? replica[depth] : 0;
+    }
+    G4int GetHistoryDepth() const final { return 2; }
+
+  private:
+    G4ThreeVector origin_;
+};
+
+//---------------------------------------------------------------------------//
+//! Get the single daughter of a volume, or null
+G4VPhysicalVolume* get_single_daughter(G4LogicalVolume const& lv)
+{
+    return lv.GetNoDaughters() == 1 ? lv.GetDaughter(0) : nullptr;
+}
+
+//---------------------------------------------------------------------------//
+//! Get the box solid of a volume, or null
+G4Box const* get_box(G4LogicalVolume const& lv)
+{
+    return dynamic_cast<G4Box const*>(lv.GetSolid());
+}
+
+//---------------------------------------------------------------------------//
+//! Get the half-width of a box along a Cartesian axis
+double get_half_width(G4Box const& box, int axis)
+{
+    switch (axis)
+    {
+        case kXAxis:
+            return box.GetXHalfLength();
+        case kYAxis:
+            return box.GetYHalfLength();
+        case kZAxis:
+            return box.GetZHalfLength();
+    }
+    G4VG_ASSERT_UNREACHABLE();
+}
+
+//---------------------------------------------------------------------------//
+//! Compare lengths with a relative tolerance
+bool soft_equal(double a, double b)
+{
+    return std::fabs(a - b)
+           <= 1e-9 * std::max({1.0, std::fabs(a), std::fabs(b)});
+}
+
+//---------------------------------------------------------------------------//
+//! Whether a box has the given half-widths along the grid axes
+template<class S>
+bool has_half_widths(G4Box const& box, S const& structure)
+{
+    for (int level = 0; level < 3; ++level)
+    {
+        if (!soft_equal(get_half_width(box, structure.axes[level]),
+                        structure.half_width[level]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace
+
+//---------------------------------------------------------------------------//
+/*!
+ * Construct with scale.
+ */
+VoxelGridConverter::VoxelGridConverter(Scaler const& convert_scale)
+    : scale_{convert_scale}
+{
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Whether the daughters of a volume form a regular voxel grid.
+ */
+bool VoxelGridConverter::is_grid(arg_type lv) const
+{
+    return static_cast<bool>(this->find_structure(lv));
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Build the voxel grid inside a volume.
+ *
+ * The material of every voxel is calculated once by the parameterisation.
+ * The VecGeom logical volume ID of the result must be set by the caller.
+ */
+auto VoxelGridConverter::operator()(arg_type lv) const -> result_type
+{
+    auto structure = this->find_structure(lv);
+    G4VG_EXPECT(structure);
+    auto const& s = *structure;
+
+    result_type result;
+    result.pv = s.voxel_pv;
+    for (int level = 0; level < 3; ++level)
+    {
+        result.dims[s.axes[level]] = s.dims[level];
+        result.half_width[s.axes[level]] = scale_(s.half_width[level]);
+    }
+    std::size_t const num_voxels = static_cast<std::size_t>(result.dims[0])
+                                   * result.dims[1] * result.dims[2];
+    result.material_ids.resize(num_voxels);
+
+    // Assign material IDs in order of the parameterisation's table
+    std::unordered_map<G4Material const*, std::uint32_t> material_ids;
+    auto get_material_id = [&](G4Material const* mat) {
+        auto [iter, inserted] = material_ids.insert(
+            {mat, static_cast<std::uint32_t>(material_ids.size())});
+        if (inserted)
+        {
+            result.materials.push_back(mat);
+        }
+        return iter->second;
+    };
+
+    if (s.phantom)
+    {
+        auto& phantom = static_cast<G4PhantomParameterisation&>(*s.param);
+        for (G4Material const* mat : phantom.GetMaterials())
+        {
+            get_material_id(mat);
+        }
+        // Phantom copy numbers are ordered with x varying fastest
+        for (std::size_t i = 0; i != num_voxels; ++i)
+        {
+            result.material_ids[i] = get_material_id(phantom.GetMaterial(i));
+        }
+        return result;
+    }
+
+    if (auto* nested = dynamic_cast<G4VNestedParameterisation*>(s.param))
+    {
+        for (int i = 0, imax = nested->GetNumberOfMaterials(); i < imax; ++i)
+        {
+            get_material_id(nested->GetMaterial(i));
+        }
+    }
+
+    // Parameterisations may change the material of the voxel volume
+    G4LogicalVolume* voxel_lv = s.voxel_pv->GetLogicalVolume();
+    G4Material* const default_mat = voxel_lv->GetMaterial();
+    VoxelTouchable touch;
+    std::array<int, 3> ijk;
+    for (int i = 0; i < s.dims[0]; ++i)
+    {
+        ijk[s.axes[0]] = i;
+        for (int j = 0; j < s.dims[1]; ++j)
+        {
+            ijk[s.axes[1]] = j;
+            touch.replica = {{j, i}};
+            for (int k = 0; k < s.dims[2]; ++k)
+            {
+                ijk[s.axes[2]] = k;
+                G4Material const* mat
+                    = s.param->ComputeMaterial(k, s.voxel_pv, &touch);
+                auto idx = ijk[0]
+                           + static_cast<std::size_t>(result.dims[0])
+                                 * (ijk[1] + result.dims[1] * ijk[2]);
+                result.material_ids[idx]
+                    = get_material_id(mat ? mat : default_mat);
+            }
+        }
+    }
+    voxel_lv->SetMaterial(default_mat);
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+// HELPERS
+//---------------------------------------------------------------------------//
+//! Find the cached volumes and dimensions of a grid in a volume
+auto VoxelGridConverter::find_structure(arg_type lv) const -> OptStructure
+{
+    auto iter = structures_.find(&lv);
+    if (iter == structures_.end())
+    {
+        iter = structures_.insert({&lv, build_structure(lv)}).first;
+    }
+    return iter->second;
+}
+
+//---------------------------------------------------------------------------//
+//! Find the volumes and dimensions of a grid in a volume
+auto VoxelGridConverter::build_structure(arg_type lv)
+    -> std::optional<Structure>
+{
+    if (!get_box(lv))
+    {
+        return std::nullopt;
+    }
+    if (auto result = find_phantom(lv))
+    {
+        return result;
+    }
+    return find_nested(lv);
+}
+
+//---------------------------------------------------------------------------//
+//! Find a phantom parameterisation that fills a box
+auto VoxelGridConverter::find_phantom(arg_type lv) -> std::optional<Structure>
+{
+    G4VPhysicalVolume* pv = get_single_daughter(lv);
+    if (!pv || pv->VolumeType() != EVolume::kParameterised)
+    {
+        return std::nullopt;
+    }
+    auto* phantom
+        = dynamic_cast<G4PhantomParameterisation*>(pv->GetParameterisation());
+    if (!phantom || pv->GetLogicalVolume()->GetNoDaughters() != 0)
+    {
+        return std::nullopt;
+    }
+
+    Structure result;
+    result.voxel_pv = pv;
+    result.param = phantom;
+    result.phantom = true;
+    result.axes = {{kXAxis, kYAxis, kZAxis}};
+    result.dims = {{static_cast<int>(phantom->GetNoVoxelsX()),
+                    static_cast<int>(phantom->GetNoVoxelsY()),
+                    static_cast<int>(phantom->GetNoVoxelsZ())}};
+    result.half_width = {{phantom->GetVoxelHalfX(),
+                          phantom->GetVoxelHalfY(),
+                          phantom->GetVoxelHalfZ()}};
+
+    auto const* box = get_box(lv);
+    for (int ax = 0; ax < 3; ++ax)
+    {
+        if (!soft_equal(get_half_width(*box, ax),
+                        result.dims[ax] * result.half_width[ax]))
+        {
+            // Voxels don't fill the container
+            return std::nullopt;
+        }
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Find a parameterisation nested in two replicas that fills a box.
+ *
+ * Each replica must divide its box mother along a different Cartesian axis,
+ * and the parameterisation must place unrotated boxes that evenly divide the
+ * innermost replica along the remaining axis. The solid and dimensions
+ * computed by the parameterisation for every copy must match the voxel box.
+ */
+auto VoxelGridConverter::find_nested(arg_type lv) -> std::optional<Structure>
+{
+    Structure result;
+
+    G4LogicalVolume const* mother = &lv;
+    for (int level = 0; level < 2; ++level)
+    {
+        G4VPhysicalVolume* pv = get_single_daughter(*mother);
+        if (!pv || pv->VolumeType() != EVolume::kReplica)
+        {
+            return std::nullopt;
+        }
+
+        EAxis axis;
+        G4int num_replicas;
+        G4double width;
+        G4double offset;
+        G4bool consuming;
+        pv->GetReplicationData(axis, num_replicas, width, offset, consuming);
+        auto const* box = get_box(*mother);
+        if (!box || (axis != kXAxis && axis != kYAxis && axis != kZAxis)
+            || (level == 1 && axis == result.axes[0])
+            || !soft_equal(num_replicas * width,
+                           2 * get_half_width(*box, axis)))
+        {
+            return std::nullopt;
+        }
+        result.axes[level] = axis;
+        result.dims[level] = num_replicas;
+        result.half_width[level] = width / 2;
+        mother = pv->GetLogicalVolume();
+    }
+
+    G4VPhysicalVolume* pv = get_single_daughter(*mother);
+    auto const* mother_box = get_box(*mother);
+    if (!pv || !mother_box || pv->VolumeType() != EVolume::kParameterised
+        || !pv->GetParameterisation() || pv->GetMultiplicity() <= 0
+        || pv->GetLogicalVolume()->GetNoDaughters() != 0)
+    {
+        return std::nullopt;
+    }
+
+    // Parameterised axis is the remaining one
+    int const axis = 3 - result.axes[0] - result.axes[1];
+    int const num_voxels = pv->GetMultiplicity();
+    double const half_width = get_half_width(*mother_box, axis) / num_voxels;
+    result.axes[2] = axis;
+    result.dims[2] = num_voxels;
+    result.half_width[2] = half_width;
+
+    // Check default voxel shape
+    auto const* voxel_box = get_box(*pv->GetLogicalVolume());
+    if (!voxel_box || !has_half_widths(*voxel_box, result))
+    {
+        return std::nullopt;
+    }
+
+    // Check that every copy is the same box, placed in order along the axis
+    G4VPVParameterisation* param = pv->GetParameterisation();
+    G4ThreeVector const orig_translation = pv->GetTranslation();
+    G4RotationMatrix* const orig_rotation = pv->GetRotation();
+    bool is_regular = true;
+    for (int i = 0; is_regular && i < num_voxels; ++i)
+    {
+        auto const* copy_box
+            = dynamic_cast<G4Box const*>(param->ComputeSolid(i, pv));
+        if (!copy_box)
+        {
+            is_regular = false;
+            break;
+        }
+        // Apply the copy's dimensions to a temporary (unregistered) box
+        G4Box box{*copy_box};
+        box.ComputeDimensions(param, i, pv);
+
+        param->ComputeTransformation(i, pv);
+        G4ThreeVector expected;
+        expected[axis] = (2 * i + 1 - num_voxels) * half_width;
+        G4RotationMatrix const* rot = pv->GetRotation();
+        G4ThreeVector const& actual = pv->GetTranslation();
+        is_regular = has_half_widths(box, result)
+                     && (!rot || rot->isIdentity())
+                     && soft_equal(actual.x(), expected.x())
+                     && soft_equal(actual.y(), expected.y())
+                     && soft_equal(actual.z(), expected.z());
+    }
+    pv->SetTranslation(orig_translation);
+    pv->SetRotation(orig_rotation);
+    if (!is_regular)
+    {
+        return std::nullopt;
+    }
+
+    result.voxel_pv = pv;
+    result.param = param;
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
@@ -0,0 +1,89 @@
+//------------------------------- -*- C++ -*- -------------------------------//
+// Copyright G4VG contributors: see top-level COPYRIGHT file for details
+// SPDX-License-Identifier: (Apache-2.0 OR MIT)
+//---------------------------------------------------------------------------//
+//! \file g4vg_impl/VoxelGridConverter.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <array>
+#include <optional>
+
+#include "G4VG.hh"
+#include "InstanceMap.hh"
+
+class G4VPVParameterisation;
+
+namespace g4vg
+{
+//---------------------------------------------------------------------------//
+class Scaler;
+
+//---------------------------------------------------------------------------//
+/*!
+ * Describe a regular grid of box voxels that fill a logical volume.
+ *
+ * Two common voxel phantom layouts are recognized:
+ * - a \c G4PhantomParameterisation placed directly in a box, and
+ * - a box filled by a replica along one axis, whose volume is filled by a
+ *   replica along a second axis, whose volume is filled by a parameterised box
+ *   along the third axis (e.g., the Geant4 DICOM "nested" example).
+ *
+ * The daughters of such a volume are not placed in VecGeom: instead, the
+ * material of each voxel is stored in a compact index array.
+ *
+ * The structure of each volume is examined only once and cached. Examining it
+ * calls the parameterisation for every copy, after which the transform of the
+ * parameterised volume is restored.
+ */
+class VoxelGridConverter
+{
+  public:
+    //!@{
+    //! \name Type aliases
+    using arg_type = G4LogicalVolume const&;
+    using result_type = Converted::VoxelGrid;
+    //!@}
+
+  public:
+    // Construct with scale
+    explicit VoxelGridConverter(Scaler const& convert_scale);
+
+    // Whether the daughters of a volume form a regular voxel grid
+    bool is_grid(arg_type) const;
+
+    // Build the voxel grid inside a volume
+    result_type operator()(arg_type) const;
+
+  private:
+    //// TYPES ////
+
+    //! Volumes and dimensions of a recognized grid
+    struct Structure
+    {
+        G4VPhysicalVolume* voxel_pv{nullptr};
+        G4VPVParameterisation* param{nullptr};
+        bool phantom{false};
+        //! Axes of outer replica, inner replica, and parameterisation
+        std::array<int, 3> axes{};
+        std::array<int, 3> dims{};
+        std::array<double, 3> half_width{};
+    };
+
+    using OptStructure = std::optional<Structure>;
+
+    //// DATA ////
+
+    Scaler const& scale_;
+    mutable InstanceMap<G4LogicalVolume const*, OptStructure> structures_;
+
+    //// HELPER FUNCTIONS ////
+
+    OptStructure find_structure(arg_type) const;
+    static std::optional<Structure> build_structure(arg_type);
+    static std::optional<Structure> find_phantom(arg_type);
+    static std::optional<Structure> find_nested(arg_type);
+};
+
+//---------------------------------------------------------------------------//
+}  // namespace g4vg
@@ -6,9 +6,13 @@
 //---------------------------------------------------------------------------//
 
 #include <array>
+#include <fstream>
+#include <iterator>
+#include <string>
 #include <vector>
 #include <G4Box.hh>
 #include <G4DisplacedSolid.hh>
+#include <G4IntersectionSolid.hh>
 #include <G4LogicalVolume.hh>
 #include <G4Material.hh>
 #include <G4NistManager.hh>
@@ -16,12 +20,23 @@
 #include <G4PVParameterised.hh>
 #include <G4PVPlacement.hh>
 #include <G4PVReplica.hh>
+#include <G4Polycone.hh>
+#include <G4Polyhedra.hh>
+#include <G4QuadrangularFacet.hh>
+#include <G4RotationMatrix.hh>
 #include <G4SolidStore.hh>
+#include <G4SubtractionSolid.hh>
 #include <G4SystemOfUnits.hh>
+#include <G4TessellatedSolid.hh>
 #include <G4ThreeVector.hh>
+#include <G4UnionSolid.hh>
 #include <G4VPhysicalVolume.hh>
 #include <G4VTouchable.hh>
 #include <gtest/gtest.h>
+#include <VecGeom/management/GeoManager.h>
+#include <VecGeom/volumes/LogicalVolume.h>
+#include <VecGeom/volumes/PlacedVolume.h>
+#include <VecGeom/volumes/UnplacedMultiUnion.h>
 
 #include "G4VG.hh"
 #include "G4VNestedParameterisation.hh"
@@ -114,6 +129,682 @@ TEST_F(DisplacedTestBase, default_options)
     result.expect_eq(ref);
 }
 
+TEST_F(DisplacedTestBase, subtree)
+{
+    G4VPhysicalVolume const* dright_pv
+        = this->g4world()->GetLogicalVolume()->GetDaughter(0);
+    ASSERT_TRUE(dright_pv);
+    ASSERT_EQ("dright_pv", dright_pv->GetName());
+
+    auto converted = g4vg::convert(dright_pv, Options{});
+    ASSERT_TRUE(converted.world);
+
+    // Only the daughter is converted, and it's placed at the origin
+    ASSERT_EQ(1u, converted.logical_volumes.size());
+    EXPECT_EQ("dright", converted.logical_volumes[0]->GetName());
+    ASSERT_EQ(1u, converted.physical_volumes.size());
+    EXPECT_EQ(dright_pv, converted.physical_volumes[0]);
+    EXPECT_TRUE(converted.world->GetTransformation()->IsIdentity());
+}
+
+TEST_F(DisplacedTestBase, transforms)
+{
+    Options opts;
+    opts.statistics = true;
+    auto converted = g4vg::convert(this->g4world(), opts);
+    ASSERT_TRUE(converted.world);
+
+    // The displaced daughter is placed at the origin
+    EXPECT_EQ(2u, converted.stats.distinct_transforms);
+    EXPECT_EQ(1u, converted.stats.identity_transforms);
+    EXPECT_EQ(1u, converted.stats.translation_transforms);
+    EXPECT_EQ(0u, converted.stats.rotation_transforms);
+}
+
+TEST_F(DisplacedTestBase, absorb_displaced)
+{
+    Options opts;
+    opts.absorb_displaced = true;
+    opts.statistics = true;
+    auto converted = g4vg::convert(this->g4world(), opts);
+    ASSERT_TRUE(converted.world);
+
+    // No boolean wrapper is needed
+    EXPECT_EQ(0u, converted.stats.temp_lvs);
+
+    // The undisplaced orb is placed with the displacement
+    G4VPhysicalVolume const* dleft_pv
+        = this->g4world()->GetLogicalVolume()->GetDaughter(1);
+    ASSERT_EQ("dleft_pv", dleft_pv->GetName());
+    auto const* found = find_pv(converted, dleft_pv, 0);
+    ASSERT_TRUE(found);
+    auto const* vgpv
+        = vecgeom::GeoManager::Instance().FindPlacedVolume(found->id);
+    ASSERT_TRUE(vgpv);
+    EXPECT_NEAR(
+        4188.79020478639, vgpv->GetUnplacedVolume()->Capacity(), 1e-8);
+    EXPECT_DOUBLE_EQ(-25.0, vgpv->GetTransformation()->Translation(0));
+}
+
+TEST_F(DisplacedTestBase, trace_file)
+{
+    Options opts;
+    opts.trace_file = this->basename() + "-trace.json";
+    auto converted = g4vg::convert(this->g4world(), opts);
+    ASSERT_TRUE(converted.world);
+
+    std::ifstream infile(opts.trace_file);
+    ASSERT_TRUE(infile);
+    std::string const trace{std::istreambuf_iterator<char>(infile),
+                            std::istreambuf_iterator<char>()};
+    EXPECT_EQ(0, trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"dleft_solid\""));
+    EXPECT_NE(std::string::npos, trace.find("\"cat\":\"placement\""));
+    EXPECT_NE(std::string::npos, trace.find("G4DisplacedSolid"));
+}
+
+TEST_F(DisplacedTestBase, update_placements)
+{
+    auto converted = g4vg::convert(this->g4world(), Options{});
+    ASSERT_TRUE(converted.world);
+
+    G4VPhysicalVolume* dright_pv
+        = this->g4world()->GetLogicalVolume()->GetDaughter(0);
+    ASSERT_EQ("dright_pv", dright_pv->GetName());
+    auto const* found = find_pv(converted, dright_pv, 0);
+    ASSERT_TRUE(found);
+    auto const* vgpv
+        = vecgeom::GeoManager::Instance().FindPlacedVolume(found->id);
+    ASSERT_TRUE(vgpv);
+    EXPECT_DOUBLE_EQ(25.0, vgpv->GetTransformation()->Translation(0));
+
+    // Move the volume and update only its placement
+    auto const orig_translation = dright_pv->GetTranslation();
+    dright_pv->SetTranslation(G4ThreeVector(30.0, 5.0, 0.0));
+    update_placements(converted, {dright_pv}, Options{});
+    dright_pv->SetTranslation(orig_translation);
+
+    EXPECT_EQ(vgpv, vecgeom::GeoManager::Instance().FindPlacedVolume(
+                        found->id));
+    EXPECT_DOUBLE_EQ(30.0, vgpv->GetTransformation()->Translation(0));
+    EXPECT_DOUBLE_EQ(5.0, vgpv->GetTransformation()->Translation(1));
+}
+
+TEST_F(DisplacedTestBase, validate_navigation)
+{
+    auto converted = g4vg::convert(this->g4world(), Options{});
+    ASSERT_TRUE(converted.world);
+    auto& vg_manager = vecgeom::GeoManager::Instance();
+    vg_manager.RegisterPlacedVolume(converted.world);
+    vg_manager.SetWorldAndClose(converted.world);
+
+    ValidateOptions vopts;
+    vopts.num_rays = 500;
+    vopts.num_threads = 2;
+    auto result = validate_navigation(converted, Options{}, vopts);
+
+    // Rays starting in the corners of the bounding box are skipped
+    EXPECT_GT(result.num_rays, 200u);
+    EXPECT_LT(result.num_rays, 500u);
+    EXPECT_GT(result.num_steps, result.num_rays);
+    EXPECT_EQ(0u, result.volume_mismatches);
+    EXPECT_EQ(0u, result.step_mismatches);
+    EXPECT_EQ(0u, result.truncated);
+    EXPECT_TRUE(result.mismatches.empty());
+}
+
+//---------------------------------------------------------------------------//
+class RotationTest : public CustomTestBase
+{
+  protected:
+    std::string basename() const final { return "rotation"; }
+    G4VPhysicalVolume* build_world() final;
+};
+
+G4VPhysicalVolume* RotationTest::build_world()
+{
+    G4Material* mat = G4NistManager::Instance()->FindOrBuildMaterial("G4_AIR");
+
+    auto* world_s = new G4Box("world_solid", 100, 100, 100);
+    auto* world_l = new G4LogicalVolume(world_s, mat, "world");
+    auto* world_p = new G4PVPlacement(G4Transform3D{},
+                                      world_l,
+                                      "world_pv",
+                                      /* parent = */ nullptr,
+                                      /* many = */ false,
+                                      /* copy_no = */ 0);
+
+    auto* box_s = new G4Box("box_solid", 10, 5, 1);
+    auto* box_l = new G4LogicalVolume(box_s, mat, "box");
+
+    // Quarter turn: an axis permutation with round-off
+    auto* quarter = new G4RotationMatrix;
+    quarter->rotateZ(90 * deg);
+    new G4PVPlacement(quarter,
+                      G4ThreeVector(0.0, 0.0, 0.0),
+                      box_l,
+                      "quarter_pv",
+                      /* parent = */ world_l,
+                      /* many = */ false,
+                      /* copy_no = */ 0);
+
+    // Full turn: the identity with round-off
+    auto* full = new G4RotationMatrix;
+    full->rotateZ(360 * deg);
+    new G4PVPlacement(full,
+                      G4ThreeVector(0.0, 0.0, 50.0),
+                      box_l,
+                      "full_pv",
+                      /* parent = */ world_l,
+                      /* many = */ false,
+                      /* copy_no = */ 1);
+
+    return world_p;
+}
+
+TEST_F(RotationTest, statistics)
+{
+    Options opts;
+    opts.statistics = true;
+    auto converted = g4vg::convert(this->g4world(), opts);
+    ASSERT_TRUE(converted.world);
+
+    EXPECT_EQ(2u, converted.stats.distinct_transforms);
+    EXPECT_EQ(0u, converted.stats.identity_transforms);
+    EXPECT_EQ(1u, converted.stats.translation_transforms);
+    EXPECT_EQ(1u, converted.stats.rotation_transforms);
+    EXPECT_EQ(1u, converted.stats.permutation_transforms);
+
+    // Snapped rotations are exact
+    auto const* world_lv = converted.world->GetLogicalVolume();
+    auto const& daughters = world_lv->GetDaughters();
+    ASSERT_EQ(2u, daughters.size());
+    auto const* quarter = daughters[0]->GetTransformation();
+    EXPECT_TRUE(quarter->HasRotation());
+    EXPECT_FALSE(quarter->HasTranslation());
+    EXPECT_EQ(0.0, quarter->Rotation(0));
+    EXPECT_EQ(1.0, quarter->Rotation(8));
+    auto const* full = daughters[1]->GetTransformation();
+    EXPECT_FALSE(full->HasRotation());
+    EXPECT_TRUE(full->HasTranslation());
+}
+
+//---------------------------------------------------------------------------//
+class NearbyTest : public CustomTestBase
+{
+  protected:
+    std::string basename() const final { return "nearby"; }
+    G4VPhysicalVolume* build_world() final;
+};
+
+G4VPhysicalVolume* NearbyTest::build_world()
+{
+    G4Material* mat = G4NistManager::Instance()->FindOrBuildMaterial("G4_AIR");
+
+    auto* world_s = new G4Box("world_solid", 100, 100, 100);
+    auto* world_l = new G4LogicalVolume(world_s, mat, "world");
+    auto* world_p = new G4PVPlacement(G4Transform3D{},
+                                      world_l,
+                                      "world_pv",
+                                      /* parent = */ nullptr,
+                                      /* many = */ false,
+                                      /* copy_no = */ 0);
+
+    auto* box_s = new G4Box("box_solid", 1, 1, 1);
+    auto* box_l = new G4LogicalVolume(box_s, mat, "box");
+
+    // The first two straddle a half-tolerance rounding boundary
+    std::array<double, 3> const x{0.5e-6 - 1e-12, 0.5e-6 + 1e-12, 50.0};
+    for (int i = 0; i < 3; ++i)
+    {
+        new G4PVPlacement(nullptr,
+                          G4ThreeVector(x[i], 0.0, 0.0),
+                          box_l,
+                          "box_pv",
+                          /* parent = */ world_l,
+                          /* many = */ false,
+                          /* copy_no = */ i);
+    }
+
+    return world_p;
+}
+
+TEST_F(NearbyTest, default_options)
+{
+    Options opts;
+    opts.statistics = true;
+    auto converted = g4vg::convert(this->g4world(), opts);
+    ASSERT_TRUE(converted.world);
+    EXPECT_EQ(3u, converted.stats.distinct_transforms);
+}
+
+TEST_F(NearbyTest, transform_tolerance)
+{
+    Options opts;
+    opts.statistics = true;
+    opts.transform_tolerance = 1e-6;
+    auto converted = g4vg::convert(this->g4world(), opts);
+    ASSERT_TRUE(converted.world);
+    EXPECT_EQ(2u, converted.stats.distinct_transforms);
+
+    // Nearby placements share the first translation exactly
+    auto const* world_lv = converted.world->GetLogicalVolume();
+    auto const& daughters = world_lv->GetDaughters();
+    ASSERT_EQ(3u, daughters.size());
+    EXPECT_EQ(daughters[0]->GetTransformation()->Translation(0),
+              daughters[1]->GetTransformation()->Translation(0));
+    EXPECT_EQ(50.0, daughters[2]->GetTransformation()->Translation(0));
+}
+
+//---------------------------------------------------------------------------//
+class TessellatedTest : public CustomTestBase
+{
+  protected:
+    std::string basename() const final { return "tessellated"; }
+    G4VPhysicalVolume* build_world() final;
+};
+
+G4VPhysicalVolume* TessellatedTest::build_world()
+{
+    G4Material* mat = G4NistManager::Instance()->FindOrBuildMaterial("G4_AIR");
+
+    auto* world_s = new G4Box("world_solid", 100, 100, 100);
+    auto* world_l = new G4LogicalVolume(world_s, mat, "world");
+    auto* world_p = new G4PVPlacement(G4Transform3D{},
+                                      world_l,
+                                      "world_pv",
+                                      /* parent = */ nullptr,
+                                      /* many = */ false,
+                                      /* copy_no = */ 0);
+
+    // Cube whose quadrilateral faces each store a copy of their corners
+    auto corner = [](int i) {
+        return G4ThreeVector(i & 1 ? 5 : -5, i & 2 ? 5 : -5, i & 4 ? 5 : -5);
+    };
+    auto* cube_s = new G4TessellatedSolid("cube_solid");
+    for (std::array<int, 4> const& face : {std::array<int, 4>{0, 2, 3, 1},
+                                           std::array<int, 4>{4, 5, 7, 6},
+                                           std::array<int, 4>{0, 1, 5, 4},
+                                           std::array<int, 4>{2, 6, 7, 3},
+                                           std::array<int, 4>{0, 4, 6, 2},
+                                           std::array<int, 4>{1, 3, 7, 5}})
+    {
+        cube_s->AddFacet(new G4QuadrangularFacet(corner(face[0]),
+                                                 corner(face[1]),
+                                                 corner(face[2]),
+                                                 corner(face[3]),
+                                                 ABSOLUTE));
+    }
+    cube_s->SetSolidClosed(true);
+    auto* cube_l = new G4LogicalVolume(cube_s, mat, "cube");
+    new G4PVPlacement(/* rotation = */ nullptr,
+                      G4ThreeVector(0.0, 0.0, 0.0),
+                      cube_l,
+                      "cube_pv",
+                      /* parent = */ world_l,
+                      /* many = */ false,
+                      /* copy_no = */ 0);
+
+    return world_p;
+}
+
+TEST_F(TessellatedTest, default_options)
+{
+    auto result = this->run(Options{});
+
+    TestResult ref;
+    ref.lv_name = {
+        "world",
+        "cube",
+    };
+    ref.solid_capacity = {
+        8000000,
+        1000,
+    };
+    ref.pv_name = {
+        "cube_pv",
+        "world_pv",
+    };
+    ref.copy_no = {
+        0,
+        0,
+    };
+    result.expect_eq(ref);
+}
+
+TEST_F(TessellatedTest, statistics)
+{
+    Options opts;
+    opts.statistics = true;
+    auto converted = g4vg::convert(this->g4world(), opts);
+    ASSERT_TRUE(converted.world);
+
+    // Six faces with four corners share eight vertices
+    EXPECT_EQ(6u * 4u - 8u, converted.stats.welded_vertices);
+    EXPECT_EQ(0u, converted.stats.degenerate_facets);
+}
+
+//---------------------------------------------------------------------------//
+class UnionTest : public CustomTestBase
+{
+  protected:
+    std::string basename() const final { return "union"; }
+    G4VPhysicalVolume* build_world() final;
+};
+
+G4VPhysicalVolume* UnionTest::build_world()
+{
+    G4Material* mat = G4NistManager::Instance()->FindOrBuildMaterial("G4_AIR");
+
+    auto* world_s = new G4Box("world_solid", 100, 100, 100);
+    auto* world_l = new G4LogicalVolume(world_s, mat, "world");
+    auto* world_p = new G4PVPlacement(G4Transform3D{},
+                                      world_l,
+                                      "world_pv",
+                                      /* parent = */ nullptr,
+                                      /* many = */ false,
+                                      /* copy_no = */ 0);
+
+    // Union tree of four separated boxes, one of them explicitly displaced
+    auto* box_s = new G4Box("box_solid", 5, 5, 5);
+    auto* right_s = new G4UnionSolid(
+        "right_solid", box_s, box_s, nullptr, G4ThreeVector(20, 0, 0));
+    auto* left_s = new G4UnionSolid(
+        "left_solid", right_s, box_s, nullptr, G4ThreeVector(-20, 0, 0));
+    auto* up_s = new G4DisplacedSolid(
+        "up_solid", box_s, nullptr, G4ThreeVector(0, 20, 0));
+    auto* cross_s = new G4UnionSolid("cross_solid", left_s, up_s);
+    auto* cross_l = new G4LogicalVolume(cross_s, mat, "cross");
+    new G4PVPlacement(/* rotation = */ nullptr,
+                      G4ThreeVector(0.0, 0.0, 0.0),
+                      cross_l,
+                      "cross_pv",
+                      /* parent = */ world_l,
+                      /* many = */ false,
+                      /* copy_no = */ 0);
+
+    // Separate union with the same constituents as the first in the tree
+    auto* pair_s = new G4UnionSolid(
+        "pair_solid", box_s, box_s, nullptr, G4ThreeVector(20, 0, 0));
+    auto* pair_l = new G4LogicalVolume(pair_s, mat, "pair");
+    new G4PVPlacement(/* rotation = */ nullptr,
+                      G4ThreeVector(0.0, -50.0, 0.0),
+                      pair_l,
+                      "pair_pv",
+                      /* parent = */ world_l,
+                      /* many = */ false,
+                      /* copy_no = */ 0);
+
+    return world_p;
+}
+
+TEST_F(UnionTest, default_options)
+{
+    Options opts;
+    opts.statistics = true;
+    auto converted = g4vg::convert(this->g4world(), opts);
+    ASSERT_TRUE(converted.world);
+
+    // Each binary union creates two temporary volumes
+    EXPECT_EQ(8u, converted.stats.temp_lvs);
+    EXPECT_EQ(0u, converted.stats.pooled_temp_volumes);
+
+    // Temporary volumes take IDs but don't correspond to Geant4 volumes
+    EXPECT_EQ(8u, converted.temp_lv_ids.size());
+    EXPECT_EQ(8u, converted.temp_pv_ids.size());
+    for (auto id : converted.temp_lv_ids)
+    {
+        EXPECT_TRUE(id >= converted.logical_volumes.size()
+                    || !converted.logical_volumes[id])
+            << "lv " << id;
+    }
+    for (auto id : converted.temp_pv_ids)
+    {
+        EXPECT_TRUE(id >= converted.physical_volumes.size()
+                    || !converted.physical_volumes[id])
+            << "pv " << id;
+    }
+}
+
+TEST_F(UnionTest, memory)
+{
+    Options opts;
+    opts.statistics = true;
+    auto converted = g4vg::convert(this->g4world(), opts);
+    ASSERT_TRUE(converted.world);
+
+    auto const& memory = converted.stats.memory;
+    EXPECT_EQ(3u, memory.logical_volumes.count);
+    EXPECT_EQ(8u, memory.temp_logical_volumes.count);
+    EXPECT_EQ(8u, memory.temp_placed_volumes.count);
+    EXPECT_EQ(3u, memory.placed_volumes.count);
+    EXPECT_GT(memory.placed_volumes.bytes, 0u);
+    EXPECT_EQ(0u, memory.tessellated_facets.count);
+
+    // World box, shared box, three unions in the cross, and the pair
+    std::size_t num_unplaced = 0;
+    for (auto&& [type, usage] : memory.unplaced)
+    {
+        num_unplaced += usage.count;
+        EXPECT_GT(usage.bytes, 0u) << type;
+    }
+    EXPECT_EQ(6u, num_unplaced);
+    EXPECT_EQ(6u, memory.solid_cache.count);
+    EXPECT_EQ(3u, memory.lv_cache.count);
+    EXPECT_EQ(3u, memory.built_daughters.count);
+}
+
+TEST_F(UnionTest, pool_temp_volumes)
+{
+    Options opts;
+    opts.statistics = true;
+    opts.pool_temp_volumes = true;
+    auto converted = g4vg::convert(this->g4world(), opts);
+    ASSERT_TRUE(converted.world);
+
+    // The pair reuses both placements from the cross
+    EXPECT_EQ(6u, converted.stats.temp_lvs);
+    EXPECT_EQ(2u, converted.stats.pooled_temp_volumes);
+}
+
+TEST_F(UnionTest, multiunion)
+{
+    Options opts;
+    opts.statistics = true;
+    opts.multiunion_threshold = 3;
+    auto converted = g4vg::convert(this->g4world(), opts);
+    ASSERT_TRUE(converted.world);
+
+    // The tree is replaced by a single union of four boxes, and the pair is
+    // below the threshold
+    EXPECT_EQ(4u + 2u, converted.stats.temp_lvs);
+    auto const* world_lv = converted.world->GetLogicalVolume();
+    auto const& daughters = world_lv->GetDaughters();
+    ASSERT_EQ(2u, daughters.size());
+    auto const* multi = dynamic_cast<vecgeom::UnplacedMultiUnion const*>(
+        daughters[0]->GetUnplacedVolume());
+    ASSERT_TRUE(multi);
+    EXPECT_EQ(4u, multi->GetNumberOfSolids());
+}
+
+TEST_F(UnionTest, verify_samples)
+{
+    Options opts;
+    opts.statistics = true;
+    opts.verify_samples = 1000;
+    opts.num_threads = 2;
+    auto converted = g4vg::convert(this->g4world(), opts);
+    ASSERT_TRUE(converted.world);
+
+    // Boolean and primitive solids agree with Geant4
+    auto const& types = converted.stats.solid_types;
+    for (char const* name : {"G4Box", "G4UnionSolid"})
+    {
+        auto iter = types.find(name);
+        ASSERT_NE(types.end(), iter) << name;
+        EXPECT_GT(iter->second.samples, 0u) << name;
+        EXPECT_EQ(0u, iter->second.mismatches) << name;
+    }
+}
+
+TEST_F(UnionTest, simplify_booleans)
+{
+    Options opts;
+    opts.statistics = true;
+    opts.simplify_booleans = true;
+    auto converted = g4vg::convert(this->g4world(), opts);
+    ASSERT_TRUE(converted.world);
+
+    // The cross is rebuilt as a balanced tree with the same number of nodes
+    EXPECT_EQ(8u, converted.stats.temp_lvs);
+    EXPECT_EQ(1u, converted.stats.rebalanced_unions);
+    EXPECT_EQ(0u, converted.stats.pruned_booleans);
+}
+
+//---------------------------------------------------------------------------//
+class PhiSegmentTest : public CustomTestBase
+{
+  protected:
+    std::string basename() const final { return "phiseg"; }
+    G4VPhysicalVolume* build_world() final;
+};
+
+G4VPhysicalVolume* PhiSegmentTest::build_world()
+{
+    G4Material* mat = G4NistManager::Instance()->FindOrBuildMaterial("G4_AIR");
+
+    auto* world_s = new G4Box("world_solid", 100, 100, 100);
+    auto* world_l = new G4LogicalVolume(world_s, mat, "world");
+    auto* world_p = new G4PVPlacement(G4Transform3D{},
+                                      world_l,
+                                      "world_pv",
+                                      /* parent = */ nullptr,
+                                      /* many = */ false,
+                                      /* copy_no = */ 0);
+
+    // Open phi segments use Geant4's thread-local phi caches
+    double const z[] = {-10, 0, 10};
+    double const rmin[] = {0, 5, 2};
+    double const rmax[] = {10, 20, 15};
+    auto* pcon_s = new G4Polycone("pcon", 0.25, 4.0, 3, z, rmin, rmax);
+    auto* pgon_s = new G4Polyhedra("pgon", 0.5, 3.0, 5, 3, z, rmin, rmax);
+    std::array<G4VSolid*, 2> const solids{pcon_s, pgon_s};
+    for (int i = 0; i < 2; ++i)
+    {
+        auto* lv = new G4LogicalVolume(solids[i], mat, solids[i]->GetName());
+        new G4PVPlacement(nullptr,
+                          G4ThreeVector(i == 0 ? -50 : 50, 0, 0),
+                          lv,
+                          solids[i]->GetName() + "_pv",
+                          /* parent = */ world_l,
+                          /* many = */ false,
+                          /* copy_no = */ 0);
+    }
+
+    return world_p;
+}
+
+TEST_F(PhiSegmentTest, verify_samples)
+{
+    // Verification results are returned without requesting statistics
+    Options opts;
+    opts.verify_samples = 2000;
+    opts.num_threads = 2;
+    auto converted = g4vg::convert(this->g4world(), opts);
+    ASSERT_TRUE(converted.world);
+
+    auto const& types = converted.stats.solid_types;
+    for (char const* name : {"G4Polycone", "G4Polyhedra"})
+    {
+        auto iter = types.find(name);
+        ASSERT_NE(types.end(), iter) << name;
+        EXPECT_GT(iter->second.samples, 0u) << name;
+        EXPECT_EQ(0u, iter->second.mismatches) << name;
+    }
+}
+
+//---------------------------------------------------------------------------//
+class BooleanTest : public CustomTestBase
+{
+  protected:
+    std::string basename() const final { return "boolean"; }
+    G4VPhysicalVolume* build_world() final;
+};
+
+G4VPhysicalVolume* BooleanTest::build_world()
+{
+    G4Material* mat = G4NistManager::Instance()->FindOrBuildMaterial("G4_AIR");
+
+    auto* world_s = new G4Box("world_solid", 100, 100, 100);
+    auto* world_l = new G4LogicalVolume(world_s, mat, "world");
+    auto* world_p = new G4PVPlacement(G4Transform3D{},
+                                      world_l,
+                                      "world_pv",
+                                      /* parent = */ nullptr,
+                                      /* many = */ false,
+                                      /* copy_no = */ 0);
+
+    // Subtraction of a box that's outside the minuend
+    auto* cube_s = new G4Box("cube_solid", 10, 10, 10);
+    auto* notch_s = new G4Box("notch_solid", 2, 2, 2);
+    auto* cut_s = new G4SubtractionSolid(
+        "cut_solid", cube_s, notch_s, nullptr, G4ThreeVector(50, 0, 0));
+    auto* cut_l = new G4LogicalVolume(cut_s, mat, "cut");
+    new G4PVPlacement(/* rotation = */ nullptr,
+                      G4ThreeVector(-30.0, 0.0, 0.0),
+                      cut_l,
+                      "cut_pv",
+                      /* parent = */ world_l,
+                      /* many = */ false,
+                      /* copy_no = */ 0);
+
+    // Intersection of an orb with a box that encloses it
+    auto* ball_s = new G4Orb("ball_solid", 8);
+    auto* clip_s = new G4Box("clip_solid", 20, 20, 20);
+    auto* clipped_s = new G4IntersectionSolid("clipped_solid", ball_s, clip_s);
+    auto* clipped_l = new G4LogicalVolume(clipped_s, mat, "clipped");
+    new G4PVPlacement(/* rotation = */ nullptr,
+                      G4ThreeVector(30.0, 0.0, 0.0),
+                      clipped_l,
+                      "clipped_pv",
+                      /* parent = */ world_l,
+                      /* many = */ false,
+                      /* copy_no = */ 0);
+
+    return world_p;
+}
+
+TEST_F(BooleanTest, default_options)
+{
+    Options opts;
+    opts.statistics = true;
+    auto converted = g4vg::convert(this->g4world(), opts);
+    ASSERT_TRUE(converted.world);
+
+    EXPECT_EQ(4u, converted.stats.temp_lvs);
+    EXPECT_EQ(0u, converted.stats.pruned_booleans);
+}
+
+TEST_F(BooleanTest, simplify_booleans)
+{
+    Options opts;
+    opts.statistics = true;
+    opts.simplify_booleans = true;
+    auto converted = g4vg::convert(this->g4world(), opts);
+    ASSERT_TRUE(converted.world);
+
+    // Both booleans are replaced by their primitive operand
+    EXPECT_EQ(0u, converted.stats.temp_lvs);
+    EXPECT_EQ(2u, converted.stats.pruned_booleans);
+    auto const& daughters
+        = converted.world->GetLogicalVolume()->GetDaughters();
+    ASSERT_EQ(2u, daughters.size());
+    EXPECT_NEAR(8000.0, daughters[0]->GetUnplacedVolume()->Capacity(), 1e-8);
+    EXPECT_NEAR(2144.66058485063,
+                daughters[1]->GetUnplacedVolume()->Capacity(),
+                1e-8);
+}
+
 //---------------------------------------------------------------------------//
 class VoxelParameterisation final : public G4VNestedParameterisation
 {
@@ -356,6 +1047,67 @@ TEST_F(NestedReplicaParametrizationTest, default_options)
     result.expect_eq(ref);
 }
 
+TEST_F(NestedReplicaParametrizationTest, compact_voxels)
+{
+    Options opts;
+    opts.compact_voxels = true;
+    auto converted = g4vg::convert(this->g4world(), opts);
+    ASSERT_TRUE(converted.world);
+
+    // Replicas and voxels are not converted
+    std::vector<std::string> lv_name;
+    for (auto const* lv : converted.logical_volumes)
+    {
+        lv_name.push_back(lv ? lv->GetName() : "<null>");
+    }
+    EXPECT_EQ((std::vector<std::string>{"world", "phantom_container"}),
+              lv_name);
+    EXPECT_EQ(2u, converted.physical_volumes.size());
+    EXPECT_TRUE(converted.nested_pv.empty());
+
+    ASSERT_EQ(1u, converted.voxel_grids.size());
+    auto const& grid = converted.voxel_grids.front();
+    EXPECT_EQ(1u, grid.lv_id);
+    ASSERT_TRUE(grid.pv);
+    EXPECT_EQ("voxel", grid.pv->GetName());
+    // Checking the grid doesn't leave the voxel at the last copy
+    EXPECT_EQ(G4ThreeVector(), grid.pv->GetTranslation());
+    EXPECT_EQ((std::array<int, 3>{{2, 3, 5}}), grid.dims);
+    EXPECT_DOUBLE_EQ(5, grid.half_width[0]);
+    EXPECT_DOUBLE_EQ(5, grid.half_width[1]);
+    EXPECT_DOUBLE_EQ(5, grid.half_width[2]);
+    ASSERT_EQ(8u, grid.materials.size());
+    EXPECT_EQ("h0", grid.materials[0]->GetName());
+    EXPECT_EQ("h7", grid.materials[7]->GetName());
+    ASSERT_EQ(30u, grid.material_ids.size());
+    for (std::size_t i = 0; i != grid.material_ids.size(); ++i)
+    {
+        EXPECT_EQ(i % 8, grid.material_ids[i]) << "voxel " << i;
+    }
+}
+
+TEST_F(NestedReplicaParametrizationTest, prune_daughters)
+{
+    Options opts;
+    opts.prune_daughters = [](G4LogicalVolume const& lv) {
+        return lv.GetName() == "phantom_container";
+    };
+    auto converted = g4vg::convert(this->g4world(), opts);
+    ASSERT_TRUE(converted.world);
+
+    // The container is an empty envelope
+    std::vector<std::string> lv_name;
+    for (auto const* lv : converted.logical_volumes)
+    {
+        lv_name.push_back(lv ? lv->GetName() : "<null>");
+    }
+    EXPECT_EQ((std::vector<std::string>{"world", "phantom_container"}),
+              lv_name);
+    EXPECT_EQ(2u, converted.physical_volumes.size());
+    EXPECT_TRUE(converted.nested_pv.empty());
+    EXPECT_TRUE(converted.voxel_grids.empty());
+}
+
 //---------------------------------------------------------------------------//
 }  // namespace test
 }  // namespace g4vg
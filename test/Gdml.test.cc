@@ -5,14 +5,21 @@
 //! \file Gdml.test.cc
 //---------------------------------------------------------------------------//
 
+#include <algorithm>
+#include <cmath>
 #include <regex>
+#include <stdexcept>
 #include <string>
 #include <G4GDMLParser.hh>
 #include <G4LogicalVolume.hh>
 #include <G4LogicalVolumeStore.hh>
 #include <G4PhysicalVolumeStore.hh>
 #include <G4SolidStore.hh>
+#include <G4VPhysicalVolume.hh>
 #include <G4Version.hh>
+#include <geomdefs.hh>
+#include <VecGeom/management/GeoManager.h>
+#include <VecGeom/volumes/LogicalVolume.h>
 #include <gtest/gtest.h>
 
 #include "G4VG.hh"
@@ -192,6 +199,17 @@ TEST_F(SolidsTest, no_pointers)
     }
 }
 
+TEST_F(SolidsTest, parallel)
+{
+    Options opts;
+    opts.compare_volumes = true;
+    opts.num_threads = 4;
+    auto result = this->run(opts);
+
+    // IDs and names must be identical to the serial conversion
+    result.expect_eq(this->base_ref());
+}
+
 //---------------------------------------------------------------------------//
 class MultiLevelTest : public GdmlTestBase
 {
@@ -293,6 +311,58 @@ TEST_F(MultiLevelTest, no_refl_factory)
     result.expect_eq(ref);
 }
 
+TEST_F(MultiLevelTest, fold_reflections)
+{
+    Options opts;
+    opts.append_pointers = false;
+    opts.reflection_factory = false;
+    opts.fold_reflections = true;
+    opts.compare_volumes = true;
+    auto result = this->run(opts);
+
+    // Reflected volumes use mirrored primitives with positive capacity
+    auto ref = this->base_ref();
+    ref.lv_name = {
+        "sph",
+        "tri",
+        "box",
+        "box2",
+        "tri_refl",
+        "world",
+        "box_refl",
+        "sph_refl",
+    };
+    ref.solid_capacity = {
+        33510.321638291127,
+        20784.609690826528,
+        3.375e+06,
+        3.375e+06,
+        20784.609690826528,
+        1.10592e+08,
+        3.375e+06,
+        33510.321638291127,
+    };
+    ref.pv_name = {
+        "topsph1",
+        "boxsph1",
+        "boxsph2",
+        "boxtri",
+        "topbox1",
+        "boxsph1",
+        "boxsph2",
+        "boxtri",
+        "topbox2",
+        "topbox3",
+        "boxsph1",
+        "boxsph2",
+        "boxtri",
+        "topbox4",
+        "world_PV",
+    };
+    ref.copy_no = {0, 31, 32, 1, 21, 41, 42, 11, 22, 23, 31, 32, 1, 24, 0};
+    result.expect_eq(ref);
+}
+
 //---------------------------------------------------------------------------//
 class CmsEeBackDeeTest : public GdmlTestBase
 {
@@ -355,6 +425,23 @@ TEST_F(CmsEeBackDeeTest, no_refl_factory)
     result.expect_eq(this->base_ref());
 }
 
+TEST_F(CmsEeBackDeeTest, fold_reflections)
+{
+    Options opts;
+    opts.append_pointers = false;
+    opts.reflection_factory = false;
+    opts.fold_reflections = true;
+    opts.compare_volumes = true;
+    auto result = this->run(opts);
+
+    auto ref = this->base_ref();
+    for (double& capacity : ref.solid_capacity)
+    {
+        capacity = std::fabs(capacity);
+    }
+    result.expect_eq(ref);
+}
+
 //---------------------------------------------------------------------------//
 class ReplicaTest : public GdmlTestBase
 {
@@ -455,6 +542,161 @@ TEST_F(ReplicaTest, default_options)
     result.expect_eq(this->base_ref());
 }
 
+TEST_F(ReplicaTest, compact_replicas)
+{
+    Options opts;
+    opts.compact_replicas = true;
+    auto converted = g4vg::convert(this->g4world(), opts);
+    ASSERT_TRUE(converted.world);
+
+    // Only the first copy of each replica is placed
+    auto ref = this->base_ref();
+    std::vector<std::string> pv_name;
+    for (std::size_t i = 0; i != ref.pv_name.size(); ++i)
+    {
+        bool is_replica = ref.pv_name[i].find("HadCal") == 0
+                          && ref.pv_name[i].find("_PV") != std::string::npos;
+        if (!is_replica || ref.copy_no[i] == 0)
+        {
+            pv_name.push_back(ref.pv_name[i]);
+        }
+    }
+    std::vector<std::string> actual_pv_name;
+    for (auto const* pv : converted.physical_volumes)
+    {
+        if (pv)
+        {
+            actual_pv_name.push_back(pv->GetName());
+        }
+    }
+    EXPECT_EQ(pv_name, actual_pv_name);
+
+    // Replicas are placed in depth-first order
+    ASSERT_EQ(3u, converted.replicas.size());
+    auto const& layer = converted.replicas[0];
+    EXPECT_EQ("HadCalLayerLogical_PV",
+              converted.physical_volumes[layer.id]->GetName());
+    EXPECT_EQ(static_cast<int>(kZAxis), layer.axis);
+    EXPECT_EQ(20, layer.count);
+    EXPECT_DOUBLE_EQ(50, layer.width);
+    EXPECT_DOUBLE_EQ(0, layer.offset);
+    auto const& cell = converted.replicas[1];
+    EXPECT_EQ(static_cast<int>(kYAxis), cell.axis);
+    EXPECT_EQ(2, cell.count);
+    EXPECT_DOUBLE_EQ(300, cell.width);
+    auto const& column = converted.replicas[2];
+    EXPECT_EQ(static_cast<int>(kXAxis), column.axis);
+    EXPECT_EQ(10, column.count);
+    EXPECT_DOUBLE_EQ(300, column.width);
+}
+
+TEST_F(ReplicaTest, volume_index)
+{
+    auto converted = g4vg::convert(this->g4world(), Options{});
+    ASSERT_TRUE(converted.world);
+
+    // Every converted volume can be found from its Geant4 pointer
+    std::size_t num_lv{0};
+    for (std::size_t i = 0; i != converted.logical_volumes.size(); ++i)
+    {
+        if (auto const* g4lv = converted.logical_volumes[i])
+        {
+            auto const* found = find_lv(converted, g4lv);
+            ASSERT_TRUE(found) << g4lv->GetName();
+            EXPECT_EQ(i, found->id);
+            ++num_lv;
+        }
+    }
+    EXPECT_EQ(num_lv, converted.lv_index.size());
+    EXPECT_EQ(converted.physical_volumes.size()
+                  - std::count(converted.physical_volumes.begin(),
+                               converted.physical_volumes.end(),
+                               nullptr),
+              converted.pv_index.size());
+    for (auto const& entry : converted.pv_index)
+    {
+        ASSERT_LT(entry.id, converted.physical_volumes.size());
+        EXPECT_EQ(entry.pv, converted.physical_volumes[entry.id]);
+        auto const* found = find_pv(converted, entry.pv, entry.copy_no);
+        ASSERT_TRUE(found);
+        EXPECT_EQ(entry.id, found->id);
+    }
+
+    // Each replica copy has a distinct ID
+    auto iter = std::find_if(converted.physical_volumes.begin(),
+                             converted.physical_volumes.end(),
+                             [](G4VPhysicalVolume const* pv) {
+                                 return pv
+                                        && pv->GetName()
+                                               == "HadCalLayerLogical_PV";
+                             });
+    ASSERT_NE(converted.physical_volumes.end(), iter);
+    auto const* layer = find_pv(converted, *iter, 0);
+    ASSERT_TRUE(layer);
+    auto const* last_layer = find_pv(converted, layer->pv, 19);
+    ASSERT_TRUE(last_layer);
+    EXPECT_NE(layer->id, last_layer->id);
+    EXPECT_FALSE(find_pv(converted, layer->pv, 20));
+    EXPECT_FALSE(find_lv(converted, nullptr));
+}
+
+TEST_F(ReplicaTest, update_placements)
+{
+    auto converted = g4vg::convert(this->g4world(), Options{});
+    ASSERT_TRUE(converted.world);
+
+    // Replicas can't be moved
+    auto const& pv_index = converted.pv_index;
+    auto iter = std::find_if(
+        pv_index.begin(), pv_index.end(), [](auto const& entry) {
+            return entry.pv->VolumeType() == EVolume::kReplica;
+        });
+    ASSERT_NE(pv_index.end(), iter);
+    EXPECT_THROW(update_placements(converted, {iter->pv}, Options{}),
+                 std::runtime_error);
+
+    // A failed update leaves earlier valid volumes in place
+    auto normal = std::find_if(
+        pv_index.begin(), pv_index.end(), [&](auto const& entry) {
+            return entry.pv->VolumeType() == EVolume::kNormal
+                   && entry.id != converted.world->id();
+        });
+    ASSERT_NE(pv_index.end(), normal);
+    auto* g4pv = const_cast<G4VPhysicalVolume*>(normal->pv);
+    auto const* vgpv
+        = vecgeom::GeoManager::Instance().FindPlacedVolume(normal->id);
+    ASSERT_TRUE(vgpv);
+    double const orig_x = vgpv->GetTransformation()->Translation(0);
+
+    auto const orig_translation = g4pv->GetTranslation();
+    g4pv->SetTranslation(orig_translation + G4ThreeVector(1.0, 0, 0));
+    EXPECT_THROW(update_placements(converted, {g4pv, iter->pv}, Options{}),
+                 std::runtime_error);
+    g4pv->SetTranslation(orig_translation);
+    EXPECT_EQ(orig_x, vgpv->GetTransformation()->Translation(0));
+}
+
+TEST_F(ReplicaTest, statistics)
+{
+    Options opts;
+    opts.statistics = true;
+    auto converted = g4vg::convert(this->g4world(), opts);
+    ASSERT_TRUE(converted.world);
+
+    auto const& stats = converted.stats;
+    EXPECT_GE(stats.discovery_time, 0);
+    EXPECT_GE(stats.solid_time, 0);
+    EXPECT_GE(stats.placement_time, 0);
+    EXPECT_GE(stats.volume_map_time, 0);
+    ASSERT_EQ(2u, stats.solid_types.size());
+    EXPECT_EQ(16u, stats.solid_types.at("G4Box").count);
+    EXPECT_EQ(1u, stats.solid_types.at("G4Tubs").count);
+    EXPECT_EQ(0u, stats.temp_lvs);
+    EXPECT_EQ(20u + 2u + 10u, stats.replica_copies);
+    EXPECT_EQ(80u, stats.param_copies);
+    EXPECT_EQ(0u, stats.deduplicated_solids);
+}
+
 //---------------------------------------------------------------------------//
 class ZnenvTest : public GdmlTestBase
 {
@@ -524,6 +766,27 @@ TEST_F(ZnenvTest, default_options)
     result.expect_eq(this->base_ref());
 }
 
+TEST_F(ZnenvTest, deduplicate)
+{
+    Options opts;
+    opts.deduplicate_solids = true;
+    auto result = this->run(opts);
+    result.expect_eq(this->base_ref());
+
+    // Identical fiber tubes and grooves should share an unplaced volume
+    auto& vg_manager = vecgeom::GeoManager::Instance();
+    auto get_solid = [&vg_manager](unsigned int lv_id) {
+        auto* vglv = vg_manager.FindLogicalVolume(lv_id);
+        EXPECT_TRUE(vglv);
+        return vglv ? vglv->GetUnplacedVolume() : nullptr;
+    };
+    EXPECT_EQ(get_solid(0), get_solid(2));
+    EXPECT_EQ(get_solid(0), get_solid(6));
+    EXPECT_EQ(get_solid(1), get_solid(7));
+    EXPECT_NE(get_solid(0), get_solid(1));
+    EXPECT_NE(get_solid(8), get_solid(9));
+}
+
 //---------------------------------------------------------------------------//
 }  // namespace test
 }  // namespace g4vg